@@ -1,4 +1,9 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Solver.h"
+#include <string_view>
 #include <iostream>
 #include <cstdint>
 #include <string>
@@ -10,10 +15,12 @@
 #include <map>
 #include <set>
 
+namespace dayXX {
+
 using DataType = std::vector<int>;
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
 	for (std::string line; reader.nextLine(line);) {
 
@@ -31,9 +38,22 @@ int partTwo(const DataType& data) {
 	return 0;
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace dayXX
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(0, dayXX::parse, dayXX::partOne, dayXX::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = dayXX::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", dayXX::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", dayXX::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,60 +1,95 @@
 #include "../common/pch.h"
-#include <iostream>
-#include <cstdint>
-#include <string>
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Scanner.h"
+#include "../utils/Solver.h"
+#include <string_view>
 #include <algorithm>
+#include <array>
 #include <numeric>
-#include <utility>
-#include <sstream>
-#include <vector>
-#include <map>
-#include <set>
-
-struct Elf {
-	std::vector<int> calories;
+#include <span>
+
+namespace day01 {
+
+// Keeps the K largest values pushed so far in fixed memory, ordered from the largest. Equal values
+// are kept as separate entries.
+template<typename T, size_t K>
+class TopK {
+public:
+	void push(T value) {
+		if (count == K && value <= values[K - 1]) {
+			return;
+		}
+		size_t position = std::min(count, K - 1);
+		for (; position > 0 && values[position - 1] < value; --position) {
+			values[position] = values[position - 1];
+		}
+		values[position] = value;
+		count = std::min(count + 1, K);
+	}
+
+	std::span<const T> getValues() const {
+		return { values.data(), count };
+	}
+
+private:
+	std::array<T, K> values{};
+	size_t count{ 0 };
 };
 
-using DataType = std::vector<Elf>;
+// Only the three best totals are ever needed, so elves are summed while reading and never stored.
+using DataType = TopK<int, 3>;
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
-	Elf elf;
-	for (std::string line; reader.nextLine(line);) {
+	int elfCalories = 0;
+	bool hasItems = false;
+	for (std::string_view line; reader.nextLine(line);) {
 		if (line.empty()) {
-			data.push_back(elf);
-			elf = Elf{};
+			if (hasItems) {
+				data.push(elfCalories);
+			}
+			elfCalories = 0;
+			hasItems = false;
 			continue;
 		}
-		auto value = std::stoi(line);
-		elf.calories.push_back(value);
+		elfCalories += common::Scanner(line).nextInt();
+		hasItems = true;
+	}
+	if (hasItems) {
+		data.push(elfCalories);
 	}
 	return data;
 }
 
 int partOne(const DataType& data) {
-	int maxCalories = 0;
-	for (const auto& elf : data) {
-		auto calories = std::accumulate(elf.calories.begin(), elf.calories.end(), 0);
-		maxCalories = std::max(calories, maxCalories);
-	}
-	return maxCalories;
+	const auto calories = data.getValues();
+	return calories.empty() ? 0 : calories.front();
 }
 
 int partTwo(const DataType& data) {
-	std::set<int> totalCalories;
-	for (const auto& elf : data) {
-		auto calories = std::accumulate(elf.calories.begin(), elf.calories.end(), 0);
-		totalCalories.insert(calories);
-	}
-	auto biggest = totalCalories.rbegin();
-	auto third = std::next(biggest, 3);
-	return std::accumulate(biggest, third, 0);
+	const auto calories = data.getValues();
+	return std::accumulate(calories.begin(), calories.end(), 0);
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day01
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(1, day01::parse, day01::partOne, day01::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day01::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day01::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day01::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,116 +1,99 @@
 #include "../common/pch.h"
-#include <iostream>
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Solver.h"
+#include <string_view>
+#include <array>
 #include <cstdint>
+#include <stdexcept>
 #include <string>
-#include <algorithm>
-#include <numeric>
-#include <utility>
-#include <sstream>
-#include <vector>
-#include <map>
-#include <set>
 
-enum Turn {
-	ROCK = 1,
-	PAPER,
-	SCISSORS
-};
-
-struct Round {
-	Turn me;
-	Turn opponent;
-};
+namespace day02 {
 
-static const std::unordered_map<char, Turn> letterMapping{
-	{'A', ROCK},
-	{'B', PAPER},
-	{'C', SCISSORS},
-	{'X', ROCK},
-	{'Y', PAPER},
-	{'Z', SCISSORS},
-};
+constexpr int SHAPES = 3;
 
-using DataType = std::vector<Round>;
+// Score of a round indexed by opponent * SHAPES + column, where both letters are taken as 0, 1 or 2.
+using ScoreTable = std::array<int, SHAPES * SHAPES>;
 
-DataType read() {
-	common::FileReader reader("input.txt");
-	DataType data;
-	for (std::string line; reader.nextLine(line);) {
-		auto letters = common::parseArray<char>(line);
-		data.push_back({ letterMapping.find(letters[1])->second, letterMapping.find(letters[0])->second });
+// Shapes are 0 for rock, 1 for paper and 2 for scissors, each shape beats the one before it.
+template<typename ChooseShape>
+constexpr ScoreTable makeScoreTable(ChooseShape chooseShape) {
+	ScoreTable table{};
+	for (int opponent = 0; opponent < SHAPES; ++opponent) {
+		for (int column = 0; column < SHAPES; ++column) {
+			const int me = chooseShape(opponent, column);
+			const int outcomeScore = (me - opponent + SHAPES + 1) % SHAPES * 3;
+			table[opponent * SHAPES + column] = me + 1 + outcomeScore;
+		}
 	}
-	return data;
+	return table;
 }
 
-Turn getWinning(Turn turn) {
-	if (turn == ROCK) {
-		return PAPER;
-	}
-	if (turn == PAPER) {
-		return SCISSORS;
-	}
-	return ROCK;
-}
+// The column is the shape to play.
+constexpr ScoreTable SHAPE_SCORES = makeScoreTable([](int, int column) {
+	return column;
+});
 
-Turn getLosing(Turn turn) {
-	if (turn == ROCK) {
-		return SCISSORS;
-	}
-	if (turn == PAPER) {
-		return ROCK;
-	}
-	return PAPER;
-}
+// The column is the outcome to reach, 0 to lose, 1 to draw and 2 to win.
+constexpr ScoreTable OUTCOME_SCORES = makeScoreTable([](int opponent, int column) {
+	return (opponent + column + SHAPES - 1) % SHAPES;
+});
 
-int calculateMyPoints(const Round& round) {
-	auto [me, op] = round;
-	if (me == op) {
-		return 3 + me;
-	}
-	if (me == getWinning(op)) {
-		return 6 + me;
-	}
-	return me;
-}
+static_assert(SHAPE_SCORES[0 * SHAPES + 1] == 8 && SHAPE_SCORES[1 * SHAPES + 0] == 1 && SHAPE_SCORES[2 * SHAPES + 2] == 6);
+static_assert(OUTCOME_SCORES[0 * SHAPES + 1] == 4 && OUTCOME_SCORES[1 * SHAPES + 0] == 1 && OUTCOME_SCORES[2 * SHAPES + 2] == 7);
+
+// Total score of every round under both readings of the second column. Rounds are scored straight
+// from the input buffer, nothing is stored per round.
+struct TournamentScores {
+	uint64_t byShape{ 0 };
+	uint64_t byOutcome{ 0 };
+};
 
-int calculateMyPointsPart2(const Round& round) {
-	enum Result {
-		LOSE = ROCK,
-		DRAW,
-		WIN,
-	};
+using DataType = TournamentScores;
 
-	auto [me, op] = round;
-	Round newRound = round;
-	if (me == DRAW) {
-		newRound.me = op;
-	} else if (me == LOSE) {
-		newRound.me = getLosing(op);
-	} else {
-		newRound.me = getWinning(op);
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
+	DataType data;
+	for (std::string_view line; reader.nextLine(line);) {
+		if (line.empty()) {
+			continue;
+		}
+		const bool isRound = line.size() == 3 && line[0] >= 'A' && line[0] <= 'C' && line[1] == ' ' && line[2] >= 'X' && line[2] <= 'Z';
+		if (!isRound) {
+			throw std::runtime_error("Invalid round: " + std::string(line));
+		}
+		const int round = (line[0] - 'A') * SHAPES + (line[2] - 'X');
+		data.byShape += SHAPE_SCORES[round];
+		data.byOutcome += OUTCOME_SCORES[round];
 	}
-	return calculateMyPoints(newRound);
+	return data;
 }
 
-int partOne(const DataType& data) {
-	int score = 0;
-	for (const auto& round : data) {
-		score += calculateMyPoints(round);
-	}
-	return score;
+uint64_t partOne(const DataType& data) {
+	return data.byShape;
 }
 
-int partTwo(const DataType& data) {
-	int score = 0;
-	for (const auto& round : data) {
-		score += calculateMyPointsPart2(round);
-	}
-	return score;
+uint64_t partTwo(const DataType& data) {
+	return data.byOutcome;
+}
+
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
 }
 
+} // namespace day02
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(2, day02::parse, day02::partOne, day02::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day02::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day02::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day02::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
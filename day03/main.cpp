@@ -1,90 +1,138 @@
 #include "../common/pch.h"
-#include <iostream>
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Solver.h"
+#include <string_view>
+#include <bit>
 #include <cstdint>
+#include <span>
+#include <stdexcept>
 #include <string>
-#include <algorithm>
-#include <numeric>
-#include <utility>
-#include <sstream>
 #include <vector>
-#include <map>
-#include <set>
 
-struct Rucksack {
-	std::string left;
-	std::string right;
+namespace day03 {
+
+// Every item type sets the bit of its priority, all 52 types fit into one word.
+using ItemMask = uint64_t;
+
+// Compartments are kept in two parallel arrays, so scoring runs over contiguous words.
+struct Rucksacks {
+	std::vector<ItemMask> left;
+	std::vector<ItemMask> right;
 };
 
-using DataType = std::vector<Rucksack>;
+using DataType = Rucksacks;
 
-DataType read() {
-	common::FileReader reader("input.txt");
-	DataType data;
-	for (std::string line; reader.nextLine(line);) {
-		Rucksack rucksack;
-		rucksack.left = line.substr(0, line.size() / 2);
-		rucksack.right = line.substr(line.size() / 2);
-		data.push_back(rucksack);
+int getPriority(char character) {
+	if (character >= 'a' && character <= 'z') {
+		return character - 'a' + 1;
 	}
-	return data;
-}
-
-bool isCharacterIn(char character, const std::string& compartment) {
-	return std::any_of(compartment.begin(), compartment.end(), [character](auto&& c) {
-		return character == c;
-	});
+	if (character >= 'A' && character <= 'Z') {
+		return character - 'A' + 27;
+	}
+	throw std::runtime_error("Invalid item: " + std::string(1, character));
 }
 
-std::string getCommonPart(const std::string& left, const std::string& right) {
-	std::set<char> result;
-	for (const auto& character : left) {
-		if (isCharacterIn(character, right)) {
-			result.insert(character);
-		}
+ItemMask toItemMask(std::string_view items) {
+	ItemMask mask = 0;
+	for (const char item : items) {
+		mask |= ItemMask{ 1 } << getPriority(item);
 	}
-	return std::string(result.begin(), result.end());
+	return mask;
 }
 
-int getPriority(char character) {
-	if (character >= 'a' && character <= 'z') {
-		return character - 'a' + 1;
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
+	DataType data;
+	for (std::string_view items; reader.nextLine(items);) {
+		data.left.push_back(toItemMask(items.substr(0, items.size() / 2)));
+		data.right.push_back(toItemMask(items.substr(items.size() / 2)));
 	}
-	return character - 'A' + 27;
+	return data;
 }
 
-int getTotalPriority(const std::string& characters) {
+int getTotalPriority(ItemMask items) {
 	int priority = 0;
-	for (auto&& character : characters) {
-		priority += getPriority(character);
+	for (; items != 0; items &= items - 1) {
+		priority += std::countr_zero(items);
 	}
 	return priority;
 }
 
-int partOne(const DataType& data) {
-	int score = 0;
-	for (const auto& rucksack : data) {
-		const auto& common = getCommonPart(rucksack.left, rucksack.right);
-		score += getTotalPriority(common);
+// Bit pattern of 2^53. ORing an even number below 2^53 into its mantissa, at half its value, gives 2^53 plus
+// that number.
+constexpr uint64_t TWO_TO_53_BITS = 0x4340'0000'0000'0000;
+
+// Priority of a mask holding at most one item, 0 for an empty mask. The mask converts exactly to a double,
+// whose exponent is the index of the item bit. Unlike std::countr_zero this needs only shifts, ORs, ANDs and
+// subtractions, which SSE2 already provides for two 64-bit lanes.
+constexpr ItemMask getSinglePriority(ItemMask item) {
+	const double value = std::bit_cast<double>(TWO_TO_53_BITS | (item >> 1)) - std::bit_cast<double>(TWO_TO_53_BITS);
+	const uint64_t exponent = std::bit_cast<uint64_t>(value) >> 52;
+	// The exponent field of 0.0 is 0, every item has a field of at least 1024.
+	return (exponent - 1023) & (0 - (exponent >> 10));
+}
+
+static_assert(getSinglePriority(0) == 0);
+static_assert(getSinglePriority(ItemMask{ 1 } << 1) == 1);
+static_assert(getSinglePriority(ItemMask{ 1 } << 52) == 52);
+
+// Scores the items common to each pair. Almost every pair shares a single item, so the batch loop scores a
+// pair without branches and without bit scan instructions, which lets compilers vectorize it: GCC 12 -O3
+// reports "loop vectorized using 16 byte vectors" for plain x86-64 and 32 byte vectors with AVX2. Only if
+// some pair shares several items the pairs are scored again by walking all set bits.
+int scoreCommonItems(std::span<const ItemMask> first, std::span<const ItemMask> second) {
+	ItemMask score = 0;
+	ItemMask severalCommonItems = 0;
+	for (size_t i = 0; i < first.size(); ++i) {
+		const ItemMask common = first[i] & second[i];
+		score += getSinglePriority(common);
+		severalCommonItems |= common & (common - 1);
+	}
+	if (severalCommonItems == 0) {
+		return static_cast<int>(score);
+	}
+	int totalScore = 0;
+	for (size_t i = 0; i < first.size(); ++i) {
+		totalScore += getTotalPriority(first[i] & second[i]);
 	}
-	return score;
+	return totalScore;
+}
+
+int partOne(const DataType& data) {
+	return scoreCommonItems(data.left, data.right);
 }
 
 int partTwo(const DataType& data) {
-	int score = 0;
-	for (int i = 0; i < data.size(); i += 3) {
-		const auto& one = data[i];
-		const auto& two = data[i+1];
-		const auto& three = data[i+2];
-		const auto& commonOneTwo = getCommonPart(one.left + one.right, two.left + two.right);
-		const auto& commonAll = getCommonPart(three.left + three.right, commonOneTwo);
-		score += getTotalPriority(commonAll);
+	constexpr size_t groupSize = 3;
+	const size_t groups = data.left.size() / groupSize;
+	std::vector<ItemMask> firstTwo(groups);
+	std::vector<ItemMask> third(groups);
+	for (size_t group = 0; group < groups; ++group) {
+		const size_t i = group * groupSize;
+		firstTwo[group] = (data.left[i] | data.right[i]) & (data.left[i + 1] | data.right[i + 1]);
+		third[group] = data.left[i + 2] | data.right[i + 2];
 	}
-	return score;
+	return scoreCommonItems(firstTwo, third);
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day03
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(3, day03::parse, day03::partOne, day03::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day03::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day03::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day03::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,81 +1,74 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Scanner.h"
+#include "../utils/Solver.h"
 #include <string>
-#include <sstream>
+#include <string_view>
+#include <algorithm>
 #include <vector>
 
-struct Assignment {
-	int min;
-	int max;
-};
+namespace day04 {
 
-struct Pair {
-	Assignment left;
-	Assignment right;
+// Pairs are stored as four parallel arrays, so the predicates run as branch free loops over
+// contiguous ints which the compiler vectorizes.
+struct Pairs {
+	std::vector<int> leftMin;
+	std::vector<int> leftMax;
+	std::vector<int> rightMin;
+	std::vector<int> rightMax;
 };
 
-using DataType = std::vector<Pair>;
+using DataType = Pairs;
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
-	for (std::string line; reader.nextLine(line);) {
-		std::istringstream stream(line);
-		Assignment left;
-		stream >> left.min;
-		stream.ignore();
-		stream >> left.max;
-		stream.ignore();
-
-		Assignment right;
-		stream >> right.min;
-		stream.ignore();
-		stream >> right.max;
-		data.push_back({left, right});
+	for (std::string_view line; reader.nextLine(line);) {
+		common::Scanner scanner(line);
+		data.leftMin.push_back(scanner.nextInt());
+		data.leftMax.push_back(scanner.nextInt());
+		data.rightMin.push_back(scanner.nextInt());
+		data.rightMax.push_back(scanner.nextInt());
 	}
 	return data;
 }
 
-bool fullyOverlap(const Pair& pair) {
-	const auto& [left, right] = pair;
-	if (left.min >= right.min && left.max <= right.max) {
-		return true;
-	}
-	if (right.min >= left.min && right.max <= left.max) {
-		return true;
-	}
-	return false;
-}
-
-bool partiallyOverlap(const Pair& pair) {
-	const auto& [left, right] = pair;
-	if (left.min <= right.max && left.max >= right.min) {
-		return true;
-	}
-	if (right.min <= left.max && right.max >= left.min) {
-		return true;
-	}
-	return false;
-}
-
 int partOne(const DataType& data) {
 	int overlapCount = 0;
-	for (const auto& pair : data) {
-		overlapCount += fullyOverlap(pair);
+	for (size_t i = 0; i < data.leftMin.size(); ++i) {
+		const bool leftInRight = (data.leftMin[i] >= data.rightMin[i]) & (data.leftMax[i] <= data.rightMax[i]);
+		const bool rightInLeft = (data.rightMin[i] >= data.leftMin[i]) & (data.rightMax[i] <= data.leftMax[i]);
+		overlapCount += leftInRight | rightInLeft;
 	}
 	return overlapCount;
 }
 
 int partTwo(const DataType& data) {
 	int overlapCount = 0;
-	for (const auto& pair : data) {
-		overlapCount += partiallyOverlap(pair);
+	for (size_t i = 0; i < data.leftMin.size(); ++i) {
+		overlapCount += (data.leftMin[i] <= data.rightMax[i]) & (data.leftMax[i] >= data.rightMin[i]);
 	}
 	return overlapCount;
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day04
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(4, day04::parse, day04::partOne, day04::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day04::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day04::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day04::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,24 +1,43 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Scanner.h"
+#include "../utils/Solver.h"
 #include <string>
+#include <string_view>
 #include <algorithm>
-#include <sstream>
+#include <cstdint>
 #include <vector>
 
+namespace day05 {
+
 struct Move {
-	int quantity;
+	uint32_t quantity;
 	int src;
 	int tgt;
 };
 
-using Stack = std::vector<char>;
+// Run of crates lying next to each other in the crate pool, listed from the bottom of the stack.
+struct Segment {
+	uint32_t begin;
+	uint32_t length;
+	// The crates are stacked in the opposite order than in the pool, the top one is at begin.
+	bool isReversed;
+};
+
+// Crates never change, stacks only rearrange segments of the pool, so moving crates splices segments
+// instead of copying them.
+using Stack = std::vector<Segment>;
 struct Input {
+	std::string crates;
 	std::vector<Stack> stacks;
 	std::vector<Move> moves;
 };
 
 using DataType = Input;
 
-void parseStackRow(std::vector<Stack>& stacks, const std::string& line) {
+void parseStackRow(std::vector<std::string>& stacks, std::string_view line) {
 	constexpr int charactersPerStack = 4;
 	for (int i = 0; i < line.size(); i += charactersPerStack) {
 		int stackIndex = i / charactersPerStack;
@@ -31,74 +50,141 @@ void parseStackRow(std::vector<Stack>& stacks, const std::string& line) {
 	}
 }
 
-Move parseMove(std::string line) {
-	common::replaceFirst(line, "move", "");
-	common::replaceFirst(line, "from", "");
-	common::replaceFirst(line, "to", "");
-	std::istringstream stream(line);
+Move parseMove(std::string_view line) {
+	common::Scanner scanner(line);
 	Move move;
-	stream >> move.quantity >> move.src >> move.tgt;
+	move.quantity = scanner.nextInt<uint32_t>();
+	move.src = scanner.nextInt();
+	move.tgt = scanner.nextInt();
 	return move;
 }
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
-	for (std::string line; reader.nextLine(line);) {
+	std::vector<std::string> stacks;
+	for (std::string_view line; reader.nextLine(line);) {
 		if (line.empty()) {
 			break;
 		}
-		if (line.find('[') == std::string::npos) {
+		if (line.find('[') == std::string_view::npos) {
 			continue;
 		}
-		parseStackRow(data.stacks, line);
+		parseStackRow(stacks, line);
 	}
-	for (auto& stack : data.stacks) {
-		std::reverse(stack.begin(), stack.end());
+	for (const auto& stack : stacks) {
+		// Rows are read from the top, so the pool holds each stack top first.
+		const auto begin = static_cast<uint32_t>(data.crates.size());
+		data.crates += stack;
+		data.stacks.push_back({});
+		if (!stack.empty()) {
+			data.stacks.back().push_back({ begin, static_cast<uint32_t>(stack.size()), true });
+		}
 	}
-	for (std::string line; reader.nextLine(line);) {
+	for (std::string_view line; reader.nextLine(line);) {
 		data.moves.push_back(parseMove(line));
 	}
 	return data;
 }
 
-std::string getStackTopElements(const std::vector<Stack>& stacks) {
+// Moves the top segments covering the given number of crates into taken, ordered from the bottom.
+// At most one segment is split.
+void takeTop(Stack& stack, uint32_t quantity, Stack& taken) {
+	taken.clear();
+	while (quantity > 0) {
+		auto& top = stack.back();
+		if (top.length <= quantity) {
+			quantity -= top.length;
+			taken.push_back(top);
+			stack.pop_back();
+			continue;
+		}
+		Segment upper{ top.begin, quantity, top.isReversed };
+		if (top.isReversed) {
+			top.begin += quantity;
+		} else {
+			upper.begin += top.length - quantity;
+		}
+		top.length -= quantity;
+		taken.push_back(upper);
+		quantity = 0;
+	}
+	std::reverse(taken.begin(), taken.end());
+}
+
+// Appends a segment on top, merging it with the top one when they continue each other in the pool.
+void putOnTop(Stack& stack, const Segment& segment) {
+	if (!stack.empty()) {
+		auto& top = stack.back();
+		if (top.isReversed == segment.isReversed) {
+			if (!top.isReversed && top.begin + top.length == segment.begin) {
+				top.length += segment.length;
+				return;
+			}
+			if (top.isReversed && segment.begin + segment.length == top.begin) {
+				top.begin = segment.begin;
+				top.length += segment.length;
+				return;
+			}
+		}
+	}
+	stack.push_back(segment);
+}
+
+std::string getStackTopElements(const std::string& crates, const std::vector<Stack>& stacks) {
 	std::string result;
 	for (const auto& stack : stacks) {
 		if (!stack.empty()) {
-			result += stack.back();
+			const auto& top = stack.back();
+			result += crates[top.isReversed ? top.begin : top.begin + top.length - 1];
 		}
 	}
 	return result;
 }
 
-std::string partOne(DataType data) {
-	auto& [stacks, moves] = data;
-	for (const auto& move : moves) {
-		auto& srcStack = stacks[move.src - 1];
+std::string partOne(const DataType& data) {
+	auto stacks = data.stacks;
+	Stack taken;
+	for (const auto& move : data.moves) {
+		takeTop(stacks[move.src - 1], move.quantity, taken);
+		// Crates are moved one at a time, which turns the taken part upside down.
 		auto& tgtStack = stacks[move.tgt - 1];
-		auto splitPoint = std::next(srcStack.begin(), srcStack.size() - move.quantity);
-		std::reverse_copy(splitPoint, srcStack.end(), std::back_inserter(tgtStack));
-		srcStack.erase(splitPoint, srcStack.end());
+		for (auto segment = taken.rbegin(); segment != taken.rend(); ++segment) {
+			putOnTop(tgtStack, { segment->begin, segment->length, !segment->isReversed });
+		}
 	}
-	return getStackTopElements(stacks);
+	return getStackTopElements(data.crates, stacks);
 }
 
-std::string partTwo(DataType data) {
-	auto& [stacks, moves] = data;
-	for (const auto& move : moves) {
-		auto& srcStack = stacks[move.src - 1];
+std::string partTwo(const DataType& data) {
+	auto stacks = data.stacks;
+	Stack taken;
+	for (const auto& move : data.moves) {
+		takeTop(stacks[move.src - 1], move.quantity, taken);
 		auto& tgtStack = stacks[move.tgt - 1];
-		auto splitPoint = std::next(srcStack.begin(), srcStack.size() - move.quantity);
-		std::copy(splitPoint, srcStack.end(), std::back_inserter(tgtStack));
-		srcStack.erase(splitPoint, srcStack.end());
+		for (const auto& segment : taken) {
+			putOnTop(tgtStack, segment);
+		}
 	}
-	return getStackTopElements(stacks);
+	return getStackTopElements(data.crates, stacks);
+}
+
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
 }
 
+} // namespace day05
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(5, day05::parse, day05::partOne, day05::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day05::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day05::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day05::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
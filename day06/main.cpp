@@ -1,39 +1,123 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Solver.h"
+#include <string_view>
 #include <string>
 #include <algorithm>
-#include <vector>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+
+namespace day06 {
 
 using DataType = std::string;
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	return reader.nextLine();
 }
 
-int findPosOfUniqueCharacters(const DataType& data, int numOfCharacters) {
-	for (auto markerStart = data.begin(); markerStart != data.end(); ++markerStart) {
-		auto markerEnd = std::next(markerStart, numOfCharacters);
-		std::vector<char> characters(markerStart, markerEnd);
-		std::sort(characters.begin(), characters.end());
-		auto sameValueFound = std::adjacent_find(characters.begin(), characters.end());
-		if (sameValueFound == characters.end()) {
-			return std::distance(data.begin(), markerEnd);
+// Finds the end of the first window of distinct characters in a signal that arrives in chunks of any size.
+//
+// Every character toggles one bit of a running xor, so the xor of a window is the difference of two running
+// values and has a bit set for each character appearing an odd number of times. The window is distinct
+// exactly when that xor has as many bits as the window has characters. Each position is tested on its own,
+// which makes the test loop free of dependencies and lets the compiler vectorize it. The work is linear in
+// the signal length whatever the window size. The signal consists of lowercase letters, anything else throws.
+template<int WindowSize>
+class MarkerDetector {
+public:
+	// Windows longer than the alphabet can never be distinct.
+	static constexpr int ALPHABET_SIZE = 26;
+	static_assert(WindowSize > 0 && WindowSize <= ALPHABET_SIZE, "The window has to fit the alphabet");
+
+	// Consumes the next chunk of the signal, returns true once the marker has been found.
+	bool feed(std::string_view chunk) {
+		while (!isFound() && !chunk.empty()) {
+			const auto block = chunk.substr(0, BLOCK_SIZE);
+			feedBlock(block);
+			chunk.remove_prefix(block.size());
 		}
+		return isFound();
 	}
-	return 0;
+
+	bool isFound() const {
+		return markerEnd != 0;
+	}
+
+	// Number of characters up to and including the marker, 0 while it has not been found.
+	uint64_t getMarkerEnd() const {
+		return markerEnd;
+	}
+
+private:
+	static constexpr int BLOCK_SIZE = 512;
+
+	void feedBlock(std::string_view block) {
+		// The first WindowSize entries carry the running xor of the end of the previous block. Before the
+		// signal starts they are zero, so windows reaching past the start simply have too few bits.
+		bool hasInvalidCharacter = false;
+		for (size_t i = 0; i < block.size(); ++i) {
+			const auto letter = static_cast<uint8_t>(block[i] - 'a');
+			hasInvalidCharacter |= letter >= ALPHABET_SIZE;
+			// Masking keeps the shift defined until an invalid character is reported after the loop.
+			runningXor[WindowSize + i] = runningXor[WindowSize + i - 1] ^ (1u << (letter & 31));
+		}
+		if (hasInvalidCharacter) {
+			throw std::runtime_error("The signal may only contain lowercase letters");
+		}
+		for (size_t i = 0; i < block.size(); ++i) {
+			const uint32_t windowXor = runningXor[WindowSize + i] ^ runningXor[i];
+			isDistinct[i] = std::popcount(windowXor) == WindowSize;
+		}
+		const auto found = std::find(isDistinct.begin(), isDistinct.begin() + block.size(), true);
+		if (found != isDistinct.begin() + block.size()) {
+			markerEnd = consumed + (found - isDistinct.begin()) + 1;
+		}
+		consumed += block.size();
+		std::copy_n(runningXor.begin() + block.size(), WindowSize, runningXor.begin());
+	}
+
+	uint64_t consumed{ 0 };
+	uint64_t markerEnd{ 0 };
+	std::array<uint32_t, WindowSize + BLOCK_SIZE> runningXor{};
+	std::array<bool, BLOCK_SIZE> isDistinct{};
+};
+
+template<int WindowSize>
+uint64_t findMarkerEnd(const DataType& data) {
+	MarkerDetector<WindowSize> detector;
+	detector.feed(data);
+	return detector.getMarkerEnd();
+}
+
+uint64_t partOne(const DataType& data) {
+	return findMarkerEnd<4>(data);
 }
 
-int partOne(const DataType& data) {
-	return findPosOfUniqueCharacters(data, 4);
+uint64_t partTwo(const DataType& data) {
+	return findMarkerEnd<14>(data);
 }
 
-int partTwo(const DataType& data) {
-	return findPosOfUniqueCharacters(data, 14);
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
 }
 
+} // namespace day06
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(6, day06::parse, day06::partOne, day06::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day06::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day06::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day06::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
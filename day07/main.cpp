@@ -1,8 +1,20 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Scanner.h"
+#include "../utils/Solver.h"
+#include <string_view>
 #include <string>
 #include <algorithm>
-#include <sstream>
-#include <list>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace day07 {
 
 constexpr int COMMAND_POS = 2;
 constexpr int COMMAND_LENGTH = 2;
@@ -14,198 +26,246 @@ enum class EntryType {
 	DIR
 };
 
-struct Entry;
+using EntryId = uint32_t;
+using NameId = uint32_t;
 
-struct Directory {
-	std::optional<int> cachedSize;
-	std::list<std::weak_ptr<Entry>> entries;
+struct Entry {
+	EntryType type;
+	NameId name;
+	EntryId parent;
+	// Size of a file, or the total size of all files below a directory.
+	int64_t size;
 };
 
-struct File {
-	int size{ 0 };
-};
+// Stores every distinct name once, entries refer to names by id.
+class NameTable {
+public:
+	NameTable() = default;
 
-struct Entry {
-	Entry(EntryType type, const std::string& name) :
-		type(type),
-		name(name) {
+	// The keys point into the deque of the table they were created in, a copy has to rebuild them.
+	NameTable(const NameTable& other) : names(other.names) {
+		rebuildIds();
 	}
-	~Entry() {}
 
-	EntryType type;
-	std::string name;
-	std::weak_ptr<Entry> parent;
+	NameTable& operator=(const NameTable& other) {
+		if (this != &other) {
+			names = other.names;
+			rebuildIds();
+		}
+		return *this;
+	}
 
-	Directory directory;
-	File file;
+	NameTable(NameTable&&) = default;
+	NameTable& operator=(NameTable&&) = default;
 
-	int getSize() {
-		if (type == EntryType::FILE) {
-			return file.size;
+	NameId intern(std::string_view name) {
+		auto found = ids.find(name);
+		if (found != ids.end()) {
+			return found->second;
 		}
-		if (directory.cachedSize.has_value()) {
-			return directory.cachedSize.value();
+		// Deque elements never move, so the keys can point into them.
+		const auto id = static_cast<NameId>(names.size());
+		ids.emplace(names.emplace_back(name), id);
+		return id;
+	}
+
+	std::string_view getName(NameId id) const {
+		return names[id];
+	}
+
+private:
+	void rebuildIds() {
+		ids.clear();
+		for (size_t id = 0; id < names.size(); ++id) {
+			ids.emplace(names[id], static_cast<NameId>(id));
 		}
-		int size = 0;
-		for (const auto& entry : directory.entries) {
-			size += entry.lock()->getSize();
+	}
+
+	std::deque<std::string> names;
+	std::unordered_map<std::string_view, NameId> ids;
+};
+
+// Tree of entries stored in one array, entries refer to each other by index.
+class FileSystem {
+public:
+	static constexpr EntryId ROOT = 0;
+
+	FileSystem() {
+		entries.push_back({ EntryType::DIR, names.intern("/"), ROOT, 0 });
+	}
+
+	EntryId getParent(EntryId id) const {
+		return entries[id].parent;
+	}
+
+	// Returns the child with the given name, it is created first if it does not exist yet. A new file adds its
+	// size to all directories above it, so sizes are up to date after every call.
+	EntryId getOrAddChild(EntryId dir, std::string_view name, EntryType type, int64_t size = 0) {
+		const NameId nameId = names.intern(name);
+		const auto [child, isNew] = children.try_emplace(getChildKey(dir, nameId), static_cast<EntryId>(entries.size()));
+		if (isNew) {
+			entries.push_back({ type, nameId, dir, type == EntryType::FILE ? size : 0 });
+			if (type == EntryType::FILE) {
+				addToDirectorySizes(dir, size);
+			}
+			isSizeIndexOutdated = true;
 		}
-		directory.cachedSize = size;
-		return size;
+		return child->second;
 	}
 
-	std::optional<std::weak_ptr<Entry>> getEntry(const std::string& entryName) {
-		auto found = std::find_if(directory.entries.begin(), directory.entries.end(), [&entryName](auto&& entry) {
-			return entry.lock()->name == entryName;
-		});
-		if (found == directory.entries.end()) {
+	// Size of the smallest directory with at least the given size. The ordered index is only rebuilt on the
+	// first query after the tree changed, later queries are a binary search.
+	std::optional<int64_t> findSmallestDirectory(int64_t minSize) const {
+		if (isSizeIndexOutdated) {
+			rebuildSizeIndex();
+		}
+		const auto found = std::lower_bound(sortedDirectorySizes.begin(), sortedDirectorySizes.end(), minSize);
+		if (found == sortedDirectorySizes.end()) {
 			return std::nullopt;
 		}
 		return *found;
 	}
+
+	const std::vector<Entry>& getEntries() const {
+		return entries;
+	}
+
+	std::string_view getName(EntryId id) const {
+		return names.getName(entries[id].name);
+	}
+
+private:
+	static uint64_t getChildKey(EntryId dir, NameId name) {
+		return static_cast<uint64_t>(dir) << 32 | name;
+	}
+
+	void addToDirectorySizes(EntryId dir, int64_t size) {
+		for (;; dir = entries[dir].parent) {
+			entries[dir].size += size;
+			if (dir == ROOT) {
+				return;
+			}
+		}
+	}
+
+	void rebuildSizeIndex() const {
+		sortedDirectorySizes.clear();
+		for (const auto& entry : entries) {
+			if (entry.type == EntryType::DIR) {
+				sortedDirectorySizes.push_back(entry.size);
+			}
+		}
+		std::sort(sortedDirectorySizes.begin(), sortedDirectorySizes.end());
+		isSizeIndexOutdated = false;
+	}
+
+	NameTable names;
+	std::vector<Entry> entries;
+	std::unordered_map<uint64_t, EntryId> children;
+	// Sizes of all directories in ascending order, a cache for findSmallestDirectory.
+	mutable std::vector<int64_t> sortedDirectorySizes;
+	mutable bool isSizeIndexOutdated{ true };
 };
 
-using DataType = std::list<std::shared_ptr<Entry>>;
+using DataType = FileSystem;
 
+// Feeds a terminal transcript line by line into a FileSystem, which can be queried in between.
 class CommandParser {
 public:
-	void parseNextLine(const std::string& line) {
-		this->line = line;
+	void parseNextLine(std::string_view line) {
 		if (line.starts_with("$")) {
-			parseCommand();
+			parseCommand(line);
 		}
 		else if (line.starts_with("dir")) {
-			parseDir();
+			parseDir(line);
 		}
 		else {
-			parseFile();
+			parseFile(line);
 		}
 	}
 
-	const DataType& getAllEntries() const {
-		return data;
+	FileSystem& getFileSystem() {
+		return fileSystem;
 	}
 
 private:
-	void parseCommand() {
-		std::string command = line.substr(COMMAND_POS, COMMAND_LENGTH);
+	void parseCommand(std::string_view line) {
+		const auto command = line.substr(COMMAND_POS, COMMAND_LENGTH);
 		if (command != "cd") {
 			return;
 		}
 
-		std::string path = line.substr(COMMAND_ARG_POS);
-		if (currentEntry.expired()) {
-			parseInitialCd(path);
-		}
-		else if (path == "..") {
-			currentEntry = currentEntry.lock()->parent;
+		const auto path = line.substr(COMMAND_ARG_POS);
+		if (path == "..") {
+			currentDir = fileSystem.getParent(currentDir);
 		}
 		else if (path == "/") {
-			currentEntry = root;
+			currentDir = FileSystem::ROOT;
 		}
 		else {
-			descendTo(path);
+			currentDir = fileSystem.getOrAddChild(currentDir, path, EntryType::DIR);
 		}
 	}
 
-	void parseInitialCd(const std::string& path) {
-		auto entry = std::make_shared<Entry>(EntryType::DIR, path);
-		data.push_back(entry);
-		currentEntry = entry;
-		root = entry;
+	void parseDir(std::string_view line) {
+		fileSystem.getOrAddChild(currentDir, line.substr(DIR_NAME_POS), EntryType::DIR);
 	}
 
-	void descendTo(const std::string& path) {
-		auto child = currentEntry.lock()->getEntry(path);
-		if (child.has_value()) {
-			currentEntry = child.value();
-		}
-		else {
-			auto entry = std::make_shared<Entry>(EntryType::DIR, path);
-			entry->parent = currentEntry;
-			currentEntry.lock()->directory.entries.push_back(entry);
-			currentEntry = entry;
-			data.push_back(entry);
-		}
-	}
-
-	void parseDir() {
-		std::string dirName = line.substr(DIR_NAME_POS);
-		auto entry = std::make_shared<Entry>(EntryType::DIR, dirName);
-		entry->parent = currentEntry;
-		currentEntry.lock()->directory.entries.push_back(entry);
-		data.push_back(entry);
-	}
-
-	void parseFile() {
-		std::istringstream stream(line);
-		int fileSize;
-		std::string fileName;
-		stream >> fileSize >> fileName;
-		auto entry = std::make_shared<Entry>(EntryType::FILE, fileName);
-		entry->parent = currentEntry;
-		entry->file.size = fileSize;
-		currentEntry.lock()->directory.entries.push_back(entry);
-		data.push_back(entry);
-	}
-
-	std::string line;
-	DataType data;
-	std::weak_ptr<Entry> currentEntry;
-	std::weak_ptr<Entry> root;
+	void parseFile(std::string_view line) {
+		common::Scanner scanner(line);
+		const auto fileSize = scanner.nextInt<int64_t>();
+		const auto fileName = line.substr(line.find(' ') + 1);
+		fileSystem.getOrAddChild(currentDir, fileName, EntryType::FILE, fileSize);
+	}
+
+	FileSystem fileSystem;
+	EntryId currentDir{ FileSystem::ROOT };
 };
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	CommandParser parser;
-	for (std::string line; reader.nextLine(line);) {
+	for (std::string_view line; reader.nextLine(line);) {
 		parser.parseNextLine(line);
 	}
-	return parser.getAllEntries();
+	return std::move(parser.getFileSystem());
 }
 
-int partOne(const DataType& data) {
-	int totalDirSize = 0;
-	for (auto&& entry : data) {
-		if (entry->type != EntryType::DIR) {
-			continue;
-		}
-		auto dirSize = entry->getSize();
-		if (dirSize <= 100000) {
-			totalDirSize += dirSize;
+int64_t partOne(const DataType& data) {
+	int64_t totalDirSize = 0;
+	for (const auto& entry : data.getEntries()) {
+		if (entry.type == EntryType::DIR && entry.size <= 100000) {
+			totalDirSize += entry.size;
 		}
 	}
 	return totalDirSize;
 }
 
-int partTwo(const DataType& data) {
-	DataType directories;
-	std::copy_if(data.begin(), data.end(), std::back_inserter(directories), [](auto&& entry) {
-		return entry->type == EntryType::DIR;
-	});
-
-	directories.sort([](auto&& left, auto&& right) {
-		return left->getSize() < right->getSize();
-	});
-
-	constexpr auto availableSpace = 70000000;
-	constexpr auto wantedSpace = 30000000;
-	const auto usedSpace = directories.back()->getSize();
+int64_t partTwo(const DataType& data) {
+	constexpr int64_t availableSpace = 70000000;
+	constexpr int64_t wantedSpace = 30000000;
+	const auto usedSpace = data.getEntries()[FileSystem::ROOT].size;
 	const auto freeSpace = availableSpace - usedSpace;
 	const auto missingSpace = wantedSpace - freeSpace;
+	return data.findSmallestDirectory(missingSpace).value_or(0);
+}
 
-	for (auto&& dir : directories) {
-		const auto dirSize = dir->getSize();
-		if (dirSize >= missingSpace) {
-			return dirSize;
-		}
-	}
-	return 0;
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
 }
 
+} // namespace day07
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(7, day07::parse, day07::partOne, day07::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day07::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day07::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day07::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,100 +1,136 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/Grid.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Solver.h"
+#include <string_view>
 #include <string>
 #include <algorithm>
 #include <utility>
 #include <vector>
-#include <set>
+#include <array>
+#include <cstdint>
 
-using DataType = std::vector<std::vector<int>>;
+namespace day08 {
 
-DataType read() {
-	common::FileReader reader("input.txt");
-	DataType data;
+using DataType = common::Grid<int>;
+
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
+	std::vector<std::string> lines;
 	for (std::string line; reader.nextLine(line);) {
-		std::vector<int> digits;
-		for (auto character : line) {
-			digits.push_back(character - '0');
+		lines.push_back(line);
+	}
+	DataType data(static_cast<int>(lines.size()), static_cast<int>(lines.front().size()));
+	for (int row = 0; row < data.getRows(); ++row) {
+		for (int col = 0; col < data.getCols(); ++col) {
+			data(row, col) = lines[row][col] - '0';
 		}
-		data.push_back(digits);
 	}
 	return data;
 }
 
-std::vector<std::pair<int, int>> getVisibleTrees(const DataType& data, int rowIdx, int colIdx, common::Dir dir) {
-	std::vector<std::pair<int, int>> visibleTrees;
-	common::MatrixIterator it(data, rowIdx, colIdx, dir);
-	for (int highestTree = -1; it.hasValue();) {
-		auto col = it.getCol();
-		auto row = it.getRow();
-		auto nextTree = it.next();
-		if (nextTree <= highestTree) {
-			continue;
+constexpr int TREE_HEIGHTS = 10;
+
+int partOne(const DataType& data) {
+	const int rows = data.getRows();
+	const int cols = data.getCols();
+	std::vector<char> isVisible(rows * cols, false);
+	// Columns are swept row by row with a running maximum per column, so every pass reads the grid in memory order.
+	std::vector<int> tallestInColumn(cols, -1);
+	for (int row = 0; row < rows; ++row) {
+		int tallestInRow = -1;
+		for (int col = 0; col < cols; ++col) {
+			const int tree = data(row, col);
+			if (tree > tallestInRow || tree > tallestInColumn[col]) {
+				isVisible[row * cols + col] = true;
+			}
+			tallestInRow = std::max(tallestInRow, tree);
+			tallestInColumn[col] = std::max(tallestInColumn[col], tree);
+		}
+	}
+	std::fill(tallestInColumn.begin(), tallestInColumn.end(), -1);
+	for (int row = rows - 1; row >= 0; --row) {
+		int tallestInRow = -1;
+		for (int col = cols - 1; col >= 0; --col) {
+			const int tree = data(row, col);
+			if (tree > tallestInRow || tree > tallestInColumn[col]) {
+				isVisible[row * cols + col] = true;
+			}
+			tallestInRow = std::max(tallestInRow, tree);
+			tallestInColumn[col] = std::max(tallestInColumn[col], tree);
 		}
-		highestTree = std::max(nextTree, highestTree);
-		visibleTrees.emplace_back(row, col);
 	}
-	return visibleTrees;
+	return static_cast<int>(std::count(isVisible.begin(), isVisible.end(), true));
 }
 
-int partOne(const DataType& data) {
-	std::set<std::pair<int, int>> visibleTrees;
-	const auto rows = data.size();
-	const auto cols = data.back().size();
-
-	for (int rowIdx = 0; rowIdx < rows; ++rowIdx) {
-		auto treesFromTheLeftSide = getVisibleTrees(data, rowIdx, 0, common::Dir::RIGHT);
-		visibleTrees.insert(treesFromTheLeftSide.begin(), treesFromTheLeftSide.end());
-
-		auto treesFromTheRightSide = getVisibleTrees(data, rowIdx, cols-1, common::Dir::LEFT);
-		visibleTrees.insert(treesFromTheRightSide.begin(), treesFromTheRightSide.end());
+// Monotonic stack of the trees able to end a view along one line. Heights are single digits, so the stack
+// collapses into the position of the closest tree at least as high as each height.
+class ViewTracker {
+public:
+	// Viewing distance of the tree at the given distance from the edge, towards the edge.
+	int look(int tree, int position) {
+		const int viewingDistance = position - blockers[tree];
+		// Fixed length and no branches, the compiler turns this into a few vector selects.
+		for (int height = 0; height < TREE_HEIGHTS; ++height) {
+			blockers[height] = height <= tree ? position : blockers[height];
+		}
+		return viewingDistance;
 	}
 
-	for (int colIdx = 0; colIdx < cols; ++colIdx) {
-		auto treesFromTheUpperSide = getVisibleTrees(data, 0, colIdx, common::Dir::BOTTOM);
-		visibleTrees.insert(treesFromTheUpperSide.begin(), treesFromTheUpperSide.end());
+private:
+	std::array<int, TREE_HEIGHTS> blockers{};
+};
 
-		auto treesFromTheBottomSide = getVisibleTrees(data, rows-1, colIdx, common::Dir::TOP);
-		visibleTrees.insert(treesFromTheBottomSide.begin(), treesFromTheBottomSide.end());
-	}
-	
-	return visibleTrees.size();
-}
-
-int calculateViewingDistance(const DataType& data, int row, int col, common::Dir dir) {
-	int houseTree = data[row][col];
-	int visibleTrees = 0;
-	common::MatrixIterator it(data, row, col, dir);
-	it.next();
-	while (it.hasValue()) {
-		++visibleTrees;
-		auto nextTree = it.next();
-		if (nextTree >= houseTree) {
-			break;
+int64_t partTwo(const DataType& data) {
+	const int rows = data.getRows();
+	const int cols = data.getCols();
+	std::vector<int> viewingDistancesUp(rows * cols);
+	std::vector<ViewTracker> columnTrackers(cols);
+	for (int row = 0; row < rows; ++row) {
+		for (int col = 0; col < cols; ++col) {
+			viewingDistancesUp[row * cols + col] = columnTrackers[col].look(data(row, col), row);
 		}
 	}
-	return visibleTrees;
-}
 
-int partTwo(const DataType& data) {
-	const auto rows = data.size();
-	const auto cols = data.back().size();
-	int maxScore = 0;
-	for (int row = 1; row < rows-1; ++row) {
-		for (int col = 1; col < cols-1; ++col) {
-			int score = 1;
-			score *= calculateViewingDistance(data, row, col, common::Dir::TOP);
-			score *= calculateViewingDistance(data, row, col, common::Dir::BOTTOM);
-			score *= calculateViewingDistance(data, row, col, common::Dir::RIGHT);
-			score *= calculateViewingDistance(data, row, col, common::Dir::LEFT);
+	int64_t maxScore = 0;
+	std::vector<int> viewingDistancesLeft(cols);
+	std::fill(columnTrackers.begin(), columnTrackers.end(), ViewTracker{});
+	for (int row = rows - 1; row >= 0; --row) {
+		ViewTracker leftTracker;
+		for (int col = 0; col < cols; ++col) {
+			viewingDistancesLeft[col] = leftTracker.look(data(row, col), col);
+		}
+		ViewTracker rightTracker;
+		for (int col = cols - 1; col >= 0; --col) {
+			const int tree = data(row, col);
+			const int64_t score = static_cast<int64_t>(viewingDistancesUp[row * cols + col]) *
+				columnTrackers[col].look(tree, rows - 1 - row) *
+				viewingDistancesLeft[col] *
+				rightTracker.look(tree, cols - 1 - col);
 			maxScore = std::max(maxScore, score);
 		}
 	}
 	return maxScore;
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day08
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(8, day08::parse, day08::partOne, day08::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day08::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day08::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day08::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
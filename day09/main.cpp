@@ -1,8 +1,17 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Solver.h"
+#include <string_view>
 #include <string>
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
 #include <vector>
-#include <set>
+
+namespace day09 {
 
 struct Step {
 	common::Dir dir;
@@ -12,13 +21,6 @@ struct Step {
 struct Pos {
 	int x;
 	int y;
-
-	bool operator<(const Pos& right) const {
-		if (x == right.x) {
-			return y < right.y;
-		}
-		return x < right.x;
-	}
 };
 
 using DataType = std::vector<Step>;
@@ -39,8 +41,8 @@ Dir determineDir(char character) {
 	return Dir::RIGHT;
 }
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
 	for (std::string line; reader.nextLine(line) && !line.empty();) {
 		Step step;
@@ -51,61 +53,129 @@ DataType read() {
 	return data;
 }
 
-bool areInRange(const Pos& left, const Pos& right) {
-	int xDiff = abs(left.x - right.x);
-	int yDiff = abs(left.y - right.y);
-	if (xDiff <= 1 && yDiff <= 1) {
-		return true;
+// Positions visited by the tail. A knot never leaves the area the head moved in, so a bitmap over that
+// area is used, unless it would be too large for memory. Then an open addressing hash set takes over.
+class VisitedSet {
+public:
+	VisitedSet(const Pos& min, const Pos& max) : min(min), width(static_cast<int64_t>(max.x) - min.x + 1) {
+		constexpr int64_t maxBitmapSize = int64_t{ 1 } << 30;
+		const int64_t area = width * (static_cast<int64_t>(max.y) - min.y + 1);
+		if (area <= maxBitmapSize) {
+			bitmap.resize(area);
+		} else {
+			slots.resize(1024, EMPTY_SLOT);
+		}
+	}
+
+	void insert(const Pos& pos) {
+		if (!bitmap.empty()) {
+			auto&& bit = bitmap[(pos.y - min.y) * width + (pos.x - min.x)];
+			count += !bit;
+			bit = true;
+			return;
+		}
+		if (insertIntoSlots(toKey(pos))) {
+			++count;
+			if (count * 2 > slots.size()) {
+				grow();
+			}
+		}
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+private:
+	static constexpr uint64_t EMPTY_SLOT = ~uint64_t{ 0 };
+
+	static uint64_t toKey(const Pos& pos) {
+		return static_cast<uint64_t>(static_cast<uint32_t>(pos.x)) << 32 | static_cast<uint32_t>(pos.y);
 	}
-	return false;
-}
 
-Pos getNewKnotPosition(const Pos& previousKnot, const Pos& knot) {
-	if (areInRange(previousKnot, knot)) {
-		return knot;
+	bool insertIntoSlots(uint64_t key) {
+		const size_t mask = slots.size() - 1;
+		for (size_t slot = (key * 0x9E3779B97F4A7C15ull) >> 32 & mask;; slot = (slot + 1) & mask) {
+			if (slots[slot] == key) {
+				return false;
+			}
+			if (slots[slot] == EMPTY_SLOT) {
+				slots[slot] = key;
+				return true;
+			}
+		}
+	}
+
+	void grow() {
+		auto oldSlots = std::exchange(slots, std::vector<uint64_t>(slots.size() * 2, EMPTY_SLOT));
+		for (const auto key : oldSlots) {
+			if (key != EMPTY_SLOT) {
+				insertIntoSlots(key);
+			}
+		}
 	}
 
+	Pos min;
+	int64_t width;
+	size_t count{ 0 };
+	std::vector<bool> bitmap;
+	std::vector<uint64_t> slots;
+};
+
+// Moves the knot towards the previous one if they stopped touching, returns whether it moved. The previous
+// knot moved by at most one square in each axis, so a single step clamped to -1, 0 or 1 catches up.
+bool followPreviousKnot(const Pos& previousKnot, Pos& knot) {
 	const int xDiff = previousKnot.x - knot.x;
 	const int yDiff = previousKnot.y - knot.y;
-	const int xUnit = xDiff != 0 ? abs(xDiff) / xDiff : 0;
-	const int yUnit = yDiff != 0 ? abs(yDiff) / yDiff : 0;
-
-	Pos newKnotPos = knot;
-	while (!areInRange(newKnotPos, previousKnot)) {
-		newKnotPos.x += xUnit;
-		newKnotPos.y += yUnit;
+	if (abs(xDiff) <= 1 && abs(yDiff) <= 1) {
+		return false;
 	}
-	return newKnotPos;
+	knot.x += (xDiff > 0) - (xDiff < 0);
+	knot.y += (yDiff > 0) - (yDiff < 0);
+	return true;
 }
 
-void moveKnots(std::vector<Pos>& knots, Dir dir) {
+// Returns whether the tail moved, knots behind one that stayed in place cannot move either.
+bool moveKnots(std::vector<Pos>& knots, Dir dir) {
 	auto& head = knots.front();
 	head.x += dir.x;
 	head.y += dir.y;
 
-	for (int knotIdx = 1; knotIdx < knots.size(); ++knotIdx) {
-		const auto& previous = knots[knotIdx - 1];
-		auto& knot = knots[knotIdx];
-		knot = getNewKnotPosition(previous, knot);
+	for (size_t knotIdx = 1; knotIdx < knots.size(); ++knotIdx) {
+		if (!followPreviousKnot(knots[knotIdx - 1], knots[knotIdx])) {
+			return false;
+		}
 	}
+	return true;
 }
 
 int countTailVisits(const DataType& data, int numKnots) {
-	std::vector<Pos> knots(numKnots, STARTING_POINT);
+	Pos head = STARTING_POINT;
+	Pos min = STARTING_POINT;
+	Pos max = STARTING_POINT;
+	for (const auto& [dir, moves] : data) {
+		head.x += dir.x * moves;
+		head.y += dir.y * moves;
+		min = { std::min(min.x, head.x), std::min(min.y, head.y) };
+		max = { std::max(max.x, head.x), std::max(max.y, head.y) };
+	}
 
-	auto& tail = knots.back();
-	std::set<Pos> visitedByTail{ tail };
+	std::vector<Pos> knots(numKnots, STARTING_POINT);
+	const auto& tail = knots.back();
+	VisitedSet visitedByTail(min, max);
+	visitedByTail.insert(tail);
 
 	for (const auto& step : data) {
 		auto [dir, moves] = step;
 
 		for (int i = 0; i < moves; ++i) {
-			moveKnots(knots, dir);
-			visitedByTail.insert({ tail.x, tail.y });
+			if (moveKnots(knots, dir)) {
+				visitedByTail.insert(tail);
+			}
 		}
 	}
 
-	return visitedByTail.size();
+	return static_cast<int>(visitedByTail.size());
 }
 
 int partOne(const DataType& data) {
@@ -116,9 +186,22 @@ int partTwo(const DataType& data) {
 	return countTailVisits(data, 10);
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day09
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(9, day09::parse, day09::partOne, day09::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day09::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day09::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day09::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,128 +1,262 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Scanner.h"
+#include "../utils/Solver.h"
+#include "../utils/Trace.h"
+#include <string_view>
 #include <string>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
 #include <vector>
 
-enum class Instruction {
-	ADDX,
-	NOOP
+namespace day10 {
+
+// The device only has the X register, the enum sizes the register file of execute.
+enum Register : uint8_t {
+	X,
+	REGISTER_COUNT
 };
 
-struct Operation {
-	Instruction instruction;
-	int value;
+enum class Opcode : uint8_t {
+	NOOP,
+	ADDX
+};
+
+constexpr int NO_REGISTER = -1;
+
+struct InstructionInfo {
+	std::string_view mnemonic;
+	Opcode opcode;
+	int cycles;
+	// Register the operand is added to once the last cycle has finished, NO_REGISTER if there is no operand.
+	int targetRegister;
 };
 
-constexpr int ADDX_CYCLES = 2;
-using DataType = std::vector<Operation>;
-
-DataType read() {
-	common::FileReader reader("input.txt");
-	DataType data;
-	for (std::string line; reader.nextLine(line);) {
-		Operation operation;
-		if (line.starts_with("addx")) {
-			operation.instruction = Instruction::ADDX;
-			operation.value = std::stoi(line.substr(5));
-		} else {
-			operation.instruction = Instruction::NOOP;
+// Indexed by opcode. A new instruction needs a row here and a case in execute.
+constexpr std::array<InstructionInfo, 2> INSTRUCTION_SET{ {
+	{ "noop", Opcode::NOOP, 1, NO_REGISTER },
+	{ "addx", Opcode::ADDX, 2, X },
+} };
+
+constexpr const InstructionInfo& getInstructionInfo(Opcode opcode) {
+	return INSTRUCTION_SET[static_cast<size_t>(opcode)];
+}
+
+static_assert(getInstructionInfo(Opcode::NOOP).opcode == Opcode::NOOP && getInstructionInfo(Opcode::ADDX).opcode == Opcode::ADDX);
+
+// Decoded program, one word per instruction with the opcode in the low byte and a signed 24 bit operand above it.
+using Bytecode = std::vector<uint32_t>;
+
+constexpr int MIN_OPERAND = -(1 << 23);
+constexpr int MAX_OPERAND = (1 << 23) - 1;
+
+constexpr uint32_t encode(Opcode opcode, int operand) {
+	return static_cast<uint32_t>(operand) << 8 | static_cast<uint8_t>(opcode);
+}
+
+constexpr Opcode getOpcode(uint32_t word) {
+	return static_cast<Opcode>(word & 0xFF);
+}
+
+constexpr int getOperand(uint32_t word) {
+	return static_cast<int32_t>(word) >> 8;
+}
+
+Bytecode decode(std::string_view input) {
+	common::LineReader reader(input);
+	Bytecode program;
+	for (std::string_view line; reader.nextLine(line);) {
+		if (line.empty()) {
+			continue;
+		}
+		common::Scanner scanner(line);
+		const auto mnemonic = scanner.nextWord();
+		const auto info = std::find_if(INSTRUCTION_SET.begin(), INSTRUCTION_SET.end(), [mnemonic](const InstructionInfo& info) {
+			return info.mnemonic == mnemonic;
+		});
+		if (info == INSTRUCTION_SET.end()) {
+			throw std::runtime_error("Unknown instruction: " + std::string(line));
 		}
-		data.push_back(operation);
+		const int64_t operand = info->targetRegister != NO_REGISTER ? scanner.nextSignedInt<int64_t>() : 0;
+		if (operand < MIN_OPERAND || operand > MAX_OPERAND) {
+			throw std::runtime_error("Operand out of range: " + std::string(line));
+		}
+		program.push_back(encode(info->opcode, static_cast<int>(operand)));
 	}
-	return data;
+	return program;
 }
 
-class Engine {
-public:
-	Engine(const DataType& operations) :
-		operations(operations),
-		currentOp(operations.begin()) {
+// Runs the program and reports every register write together with the cycle from which the new value
+// holds. Returns the first cycle after the program.
+template<typename OnWrite>
+int64_t execute(const Bytecode& program, OnWrite onWrite) {
+	AOC_TRACE_SPAN("execute");
+	std::array<int, REGISTER_COUNT> registers;
+	registers.fill(1);
+	int64_t cycle = 1;
+	for (const uint32_t word : program) {
+		const Opcode opcode = getOpcode(word);
+		const auto& info = getInstructionInfo(opcode);
+		cycle += info.cycles;
+		switch (opcode) {
+		case Opcode::NOOP:
+			break;
+		case Opcode::ADDX:
+			registers[info.targetRegister] += getOperand(word);
+			onWrite(cycle, info.targetRegister, registers[info.targetRegister]);
+			break;
+		}
 	}
+	AOC_TRACE_ADD("instructions", program.size());
+	return cycle;
+}
 
-	void nextCycle() {
-		if (!executionBlocked) {
-			if (currentCycle != 1) {
-				++currentOp;
-			}
-			if (currentOp->instruction == Instruction::ADDX) {
-				lockedUntilCycleEnd = currentCycle + ADDX_CYCLES - 1;
-				executionBlocked = true;
-			}
-		}
+// From this cycle on the register holds the value, until the next change point.
+struct ChangePoint {
+	int64_t cycle;
+	int value;
+};
 
-		if (lockedUntilCycleEnd == currentCycle) {
-			registerValue += currentOp->value;
-			executionBlocked = false;
-		}
-		++currentCycle;
+// Value of the X register over the whole program, stored as the cycles at which it changes. Values at
+// any cycle are looked up without running the program cycle by cycle.
+class RegisterTimeline {
+public:
+	explicit RegisterTimeline(const Bytecode& program) {
+		changePoints.push_back({ 1, 1 });
+		execute(program, [this](int64_t cycle, int targetRegister, int value) {
+			if (targetRegister == X) {
+				changePoints.push_back({ cycle, value });
+			}
+		});
 	}
 
-	int getCurrentCycle() const {
-		return currentCycle;
+	// Register value during the given cycle, O(log n).
+	int getValueDuring(int64_t cycle) const {
+		const auto next = std::upper_bound(changePoints.begin(), changePoints.end(), cycle, [](int64_t cycle, const ChangePoint& changePoint) {
+			return cycle < changePoint.cycle;
+		});
+		return std::prev(next)->value;
 	}
 
-	int getRegisterValue() const {
-		return registerValue;
+	const std::vector<ChangePoint>& getChangePoints() const {
+		return changePoints;
 	}
 
 private:
-	DataType operations;
-	DataType::const_iterator currentOp;
-	int currentCycle{ 1 };
-	int registerValue{ 1 };
-	int lockedUntilCycleEnd{ 0 };
-	bool executionBlocked{ false };
+	std::vector<ChangePoint> changePoints;
 };
 
+using DataType = RegisterTimeline;
+
+DataType parse(std::string_view input) {
+	return RegisterTimeline(decode(input));
+}
+
 int partOne(const DataType& data) {
-	std::vector<int> cyclesToCheck{220, 180, 140, 100, 60, 20};
+	constexpr int firstCycleToCheck = 20;
+	constexpr int lastCycleToCheck = 220;
+	constexpr int cyclesBetweenChecks = 40;
 	int signalStrength = 0;
-
-	Engine engine(data);
-	while (!cyclesToCheck.empty()) {
-		int cycleIdx = engine.getCurrentCycle();
-		if (cyclesToCheck.back() == cycleIdx) {
-			cyclesToCheck.pop_back();
-			signalStrength += engine.getRegisterValue() * cycleIdx;
-		}
-		engine.nextCycle();
+	for (int cycle = firstCycleToCheck; cycle <= lastCycleToCheck; cycle += cyclesBetweenChecks) {
+		signalStrength += data.getValueDuring(cycle) * cycle;
 	}
 	return signalStrength;
 }
 
-std::string partTwo(const DataType& data) {
-	constexpr int crtWidth = 40;
-	constexpr int crtHeight = 6;
-	constexpr int totalPixels = crtWidth * crtHeight;
-
-	std::vector<std::vector<char>> crt(crtHeight, std::vector<char>(crtWidth, '.'));
-	int pixelsDrawn = 0;
-
-	Engine engine(data);
-	while (pixelsDrawn < totalPixels) {
-		auto& row = crt[pixelsDrawn / crtWidth];
-		const int pixelPos = pixelsDrawn % crtWidth;
-		const int spritePos = engine.getRegisterValue();
-		if (pixelPos >= spritePos - 1 && pixelPos <= spritePos + 1) {
-			row[pixelPos] = '#';
-		}
-		++pixelsDrawn;
+constexpr int CRT_WIDTH = 40;
+constexpr int CRT_HEIGHT = 6;
+constexpr int GLYPH_WIDTH = 4;
+constexpr int GLYPH_SPACING = 5;
+
+// Letters of the CRT font, the pixels of a glyph row by row.
+struct Glyph {
+	char letter;
+	std::string_view pixels;
+};
 
-		engine.nextCycle();
+constexpr std::array<Glyph, 18> FONT{ {
+	{ 'A', ".##.#..##..######..##..#" },
+	{ 'B', "###.#..####.#..##..####." },
+	{ 'C', ".##.#..##...#...#..#.##." },
+	{ 'E', "#####...###.#...#...####" },
+	{ 'F', "#####...###.#...#...#..." },
+	{ 'G', ".##.#..##...#.###..#.###" },
+	{ 'H', "#..##..######..##..##..#" },
+	{ 'I', ".###..#...#...#...#..###" },
+	{ 'J', "..##...#...#...##..#.##." },
+	{ 'K', "#..##.#.##..#.#.#.#.#..#" },
+	{ 'L', "#...#...#...#...#...####" },
+	{ 'O', ".##.#..##..##..##..#.##." },
+	{ 'P', "###.#..##..####.#...#..." },
+	{ 'R', "###.#..##..####.#.#.#..#" },
+	{ 'S', ".####...#....##....####." },
+	{ 'U', "#..##..##..##..##..#.##." },
+	{ 'Y', "#...#....#.#..#...#...#." },
+	{ 'Z', "####...#..#..#..#...####" },
+} };
+
+static_assert(std::all_of(FONT.begin(), FONT.end(), [](const Glyph& glyph) {
+	return glyph.pixels.size() == GLYPH_WIDTH * CRT_HEIGHT;
+}));
+
+// Reads the letters off the screen, '?' stands for a glyph outside the font.
+std::string readLetters(std::string_view screen) {
+	std::string letters;
+	for (int left = 0; left + GLYPH_WIDTH <= CRT_WIDTH; left += GLYPH_SPACING) {
+		const auto glyph = std::find_if(FONT.begin(), FONT.end(), [screen, left](const Glyph& glyph) {
+			for (int row = 0; row < CRT_HEIGHT; ++row) {
+				if (screen.substr(row * CRT_WIDTH + left, GLYPH_WIDTH) != glyph.pixels.substr(row * GLYPH_WIDTH, GLYPH_WIDTH)) {
+					return false;
+				}
+			}
+			return true;
+		});
+		letters += glyph != FONT.end() ? glyph->letter : '?';
 	}
+	return letters;
+}
+
+std::string partTwo(const DataType& data) {
+	constexpr int totalPixels = CRT_WIDTH * CRT_HEIGHT;
 
-	for (const auto& row : crt) {
-		for (const auto& pixel : row) {
-			std::cout << pixel;
+	// Pixels are drawn in cycle order, so the change points are merged in while drawing.
+	const auto& changePoints = data.getChangePoints();
+	auto current = changePoints.begin();
+	std::string screen;
+	screen.reserve(totalPixels);
+	for (int pixelsDrawn = 0; pixelsDrawn < totalPixels; ++pixelsDrawn) {
+		const int64_t cycle = pixelsDrawn + 1;
+		while (std::next(current) != changePoints.end() && std::next(current)->cycle <= cycle) {
+			++current;
 		}
-		std::cout << '\n';
+		const int pixelPos = pixelsDrawn % CRT_WIDTH;
+		const int spritePos = current->value;
+		screen += pixelPos >= spritePos - 1 && pixelPos <= spritePos + 1 ? '#' : '.';
 	}
+	return readLetters(screen);
+}
 
-	return "EJCFPGLH";
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
 }
 
+} // namespace day10
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(10, day10::parse, day10::partOne, day10::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day10::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day10::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day10::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
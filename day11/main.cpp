@@ -1,219 +1,290 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Parallel.h"
+#include "../utils/Scanner.h"
+#include "../utils/Solver.h"
+#include <string_view>
 #include <string>
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <mutex>
 #include <numeric>
 #include <vector>
-#include <map>
-#include <deque>
-#include <functional>
-
-class Monkey;
-using InspectFunction = std::function<uint64_t(uint64_t)>;
-using DataType = std::map<int, Monkey>;
-
-class Item {
-public:
-	Item(uint64_t worryLevel) : worryLevel(worryLevel) {}
-
-	void inspect(InspectFunction inspectFunction) {
-		worryLevel = inspectFunction(worryLevel);
-	}
 
-	void inspectWithLcm(InspectFunction inspectFunction, uint64_t lcm) {
-		worryLevel = inspectFunction(worryLevel);
-		worryLevel %= lcm;
-	}
+namespace day11 {
 
-	void divideWorryLevel() {
-		worryLevel /= 3;
-	}
+enum class OperationType : uint8_t {
+	ADD,
+	MULTIPLY,
+	SQUARE
+};
 
-	bool test(uint64_t divisor) const {
-		return worryLevel % divisor == 0;
-	}
+struct Operation {
+	OperationType type;
+	uint64_t value;
+};
 
-private:
-	uint64_t worryLevel;
+// Monkeys are indexed densely in the order of the input, targets refer to these indices.
+struct Monkey {
+	Operation operation;
+	uint64_t divisor;
+	int trueTarget;
+	int falseTarget;
 };
 
-struct ResultMap {
-	int trueTestMonkeyId;
-	int falseTestMoneyId;
+// Items are two parallel arrays, the starting worry level and the index of the monkey holding the item.
+struct Input {
+	std::vector<Monkey> monkeys;
+	std::vector<uint64_t> itemWorryLevels;
+	std::vector<int> itemHolders;
 };
 
-class Monkey {
-public:
-	Monkey() {}
-	Monkey(int id,
-		InspectFunction inspectFunction,
-		uint64_t divisor,
-		ResultMap resultMap) :
-		id(id),
-		inspectFunction(inspectFunction),
-		divisor(divisor),
-		resultMap(resultMap) {
-	}
+using DataType = Input;
 
-	void addItem(const Item& item) {
-		items.push_back(item);
+uint64_t apply(const Operation& operation, uint64_t worryLevel) {
+	switch (operation.type) {
+	case OperationType::ADD:
+		return worryLevel + operation.value;
+	case OperationType::MULTIPLY:
+		return worryLevel * operation.value;
+	case OperationType::SQUARE:
+		return worryLevel * worryLevel;
 	}
+	return worryLevel;
+}
 
-	void inspectAndThrow(DataType& monkeys) {
-		while (!items.empty()) {
-			auto item = items.front();
-			items.pop_front();
-
-			item.inspect(inspectFunction);
-			item.divideWorryLevel();
-			throwItem(monkeys, item);
-			++numInspectedItems;
-		}
+Operation parseOperation(std::string_view line) {
+	if (line.rfind("old") != line.find("old")) {
+		return { OperationType::SQUARE, 0 };
 	}
+	const auto type = line.find('*') != std::string_view::npos ? OperationType::MULTIPLY : OperationType::ADD;
+	return { type, common::Scanner(line).nextInt<uint64_t>() };
+}
 
-	void inspectAndThrowWithLcm(DataType& monkeys, uint64_t lcm) {
-		while (!items.empty()) {
-			auto item = items.front();
-			items.pop_front();
-
-			item.inspectWithLcm(inspectFunction, lcm);
-			throwItem(monkeys, item);
-			++numInspectedItems;
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
+	DataType data;
+	std::vector<int> monkeyIds;
+	for (std::string_view line; reader.nextLine(line);) {
+		if (line.empty()) {
+			continue;
+		}
+		monkeyIds.push_back(common::Scanner(line).nextInt());
+		const auto monkeyIdx = static_cast<int>(data.monkeys.size());
+
+		reader.nextLine(line);
+		common::Scanner itemScanner(line);
+		for (uint64_t worryLevel; itemScanner.tryNextInt(worryLevel);) {
+			data.itemWorryLevels.push_back(worryLevel);
+			data.itemHolders.push_back(monkeyIdx);
 		}
-	}
 
-	uint64_t getNumInspectedItems() const {
-		return numInspectedItems;
+		Monkey monkey;
+		reader.nextLine(line);
+		monkey.operation = parseOperation(line);
+		reader.nextLine(line);
+		monkey.divisor = common::Scanner(line).nextInt<uint64_t>();
+		reader.nextLine(line);
+		monkey.trueTarget = common::Scanner(line).nextInt();
+		reader.nextLine(line);
+		monkey.falseTarget = common::Scanner(line).nextInt();
+		data.monkeys.push_back(monkey);
 	}
 
-	uint64_t getDivisor() const {
-		return divisor;
+	const auto toIndex = [&monkeyIds](int monkeyId) {
+		return static_cast<int>(std::find(monkeyIds.begin(), monkeyIds.end(), monkeyId) - monkeyIds.begin());
+	};
+	for (auto& monkey : data.monkeys) {
+		monkey.trueTarget = toIndex(monkey.trueTarget);
+		monkey.falseTarget = toIndex(monkey.falseTarget);
 	}
+	return data;
+}
 
-private:
-	void throwItem(DataType& monkeys, const Item& item) {
-		if (item.test(divisor)) {
-			monkeys[resultMap.trueTestMonkeyId].addItem(item);
-		} else {
-			monkeys[resultMap.falseTestMoneyId].addItem(item);
-		}
-	}
-
-	int id;
-	std::deque<Item> items;
-	InspectFunction inspectFunction;
-	uint64_t divisor;
-	ResultMap resultMap;
-	uint64_t numInspectedItems{ 0 };
-};
-
-InspectFunction parseOperation(std::string line) {
-	if (line.rfind("old") != line.find("old")) {
-		return [](uint64_t worryLevel) {return worryLevel * worryLevel; };
+// Plays the rounds and returns how many items each monkey inspected.
+template<typename ReduceWorry>
+std::vector<uint64_t> simulate(const DataType& data, int numRounds, ReduceWorry reduceWorry) {
+	const size_t numMonkeys = data.monkeys.size();
+	const size_t numItems = data.itemWorryLevels.size();
+	// Every monkey has room for all items, so throwing an item never allocates.
+	std::vector<uint64_t> queues(numMonkeys * numItems);
+	std::vector<size_t> queueSizes(numMonkeys, 0);
+	for (size_t item = 0; item < numItems; ++item) {
+		const int holder = data.itemHolders[item];
+		queues[holder * numItems + queueSizes[holder]++] = data.itemWorryLevels[item];
 	}
 
-	char multiplicationPos = line.find('*');
-	if (multiplicationPos != std::string::npos) {
-		uint64_t value = std::stoi(line.substr(multiplicationPos + 2));
-		return [value](uint64_t worryLevel) {return worryLevel * value; };
+	std::vector<uint64_t> numInspectedItems(numMonkeys, 0);
+	for (int round = 0; round < numRounds; ++round) {
+		for (size_t monkeyIdx = 0; monkeyIdx < numMonkeys; ++monkeyIdx) {
+			const auto& monkey = data.monkeys[monkeyIdx];
+			const uint64_t* queue = queues.data() + monkeyIdx * numItems;
+			for (size_t i = 0; i < queueSizes[monkeyIdx]; ++i) {
+				const uint64_t worryLevel = reduceWorry(apply(monkey.operation, queue[i]));
+				const int target = worryLevel % monkey.divisor == 0 ? monkey.trueTarget : monkey.falseTarget;
+				queues[target * numItems + queueSizes[target]++] = worryLevel;
+			}
+			numInspectedItems[monkeyIdx] += queueSizes[monkeyIdx];
+			queueSizes[monkeyIdx] = 0;
+		}
 	}
-
-	uint64_t value = std::stoi(line.substr(line.find('+') + 2));
-	return [value](uint64_t worryLevel) {return worryLevel + value; };
+	return numInspectedItems;
 }
 
-uint64_t parseTest(std::string line) {
-	line = line.substr(line.find("by") + 3);
-	return std::stoi(line);
+uint64_t calculateMonkeyActivity(std::vector<uint64_t> monkeyActivity) {
+	std::partial_sort(monkeyActivity.begin(), monkeyActivity.begin() + 2, monkeyActivity.end(), std::greater<>());
+	return monkeyActivity[0] * monkeyActivity[1];
 }
 
-DataType read() {
-	common::FileReader reader("input.txt");
-	DataType data;
-	for (std::string line; reader.nextLine(line);) {
-		if (line.empty()) {
-			continue;
-		}
-
-		const std::string onkey = "onkey";
-		int monkeyId = std::stoi(line.substr(line.find(onkey) + onkey.size()));
-
-		line = reader.nextLine();
-		auto items = common::parseArray<uint64_t, Item>(line.substr(line.find(':') + 1), ',');
-
-		line = reader.nextLine();
-		InspectFunction inspectFunction = parseOperation(line);
+uint64_t calculateLcm(const DataType& data) {
+	uint64_t lcm = 1;
+	for (const auto& monkey : data.monkeys) {
+		lcm = std::lcm(lcm, monkey.divisor);
+	}
+	return lcm;
+}
 
-		line = reader.nextLine();
-		uint64_t divisor = parseTest(line);
+// Monkeys that inspected one item during one round, one bit per monkey. Within a round an item only moves
+// on to monkeys with a higher index, so every monkey inspects it at most once.
+using RoundInspections = uint64_t;
+constexpr size_t MAX_TRAJECTORY_MONKEYS = 64;
 
-		line = reader.nextLine();
-		int trueId = std::stoi(line.substr(line.find(onkey) + onkey.size()));
+struct ItemState {
+	int monkey;
+	uint64_t worryLevel;
 
-		line = reader.nextLine();
-		int falseId = std::stoi(line.substr(line.find(onkey) + onkey.size()));
+	bool operator==(const ItemState&) const = default;
+};
 
-		Monkey monkey(monkeyId, inspectFunction, divisor, {trueId, falseId});
-		std::for_each(items.begin(), items.end(), [&monkey](const auto& item) {
-			monkey.addItem(item);
-		});
-		data.insert({ monkeyId, monkey });
+// Plays one round for a single item and leaves it with the monkey holding it at the start of the next round.
+RoundInspections playRound(const DataType& data, ItemState& item, uint64_t lcm) {
+	RoundInspections inspections = 0;
+	for (int monkeyIdx = item.monkey;;) {
+		const auto& monkey = data.monkeys[monkeyIdx];
+		inspections |= RoundInspections{ 1 } << monkeyIdx;
+		item.worryLevel = apply(monkey.operation, item.worryLevel) % lcm;
+		const int target = item.worryLevel % monkey.divisor == 0 ? monkey.trueTarget : monkey.falseTarget;
+		if (target < monkeyIdx) {
+			item.monkey = target;
+			return inspections;
+		}
+		monkeyIdx = target;
 	}
-	return data;
 }
 
-uint64_t calculateMonkeyActivity(const DataType& data) {
-	std::vector<uint64_t> monkeyActivity;
-	std::transform(data.begin(), data.end(), std::back_inserter(monkeyActivity), [](auto&& entry) {
-		return entry.second.getNumInspectedItems();
-		});
+// The history of one trajectory, kept by each worker so that its allocations are reused between items.
+struct Trajectory {
+	std::vector<ItemState> states;
+	std::vector<RoundInspections> rounds;
+};
 
-	std::sort(monkeyActivity.begin(), monkeyActivity.end(), std::greater<>());
+// Adds how often each monkey inspects a single item during the given number of rounds. With worry levels
+// kept modulo the lcm an item only has finitely many states, so its rounds eventually repeat. Brent's cycle
+// detection finds the cycle without hashing states, the remaining rounds are then extrapolated from it.
+void addItemInspections(const DataType& data, size_t item, uint64_t numRounds, uint64_t lcm, Trajectory& trajectory,
+		std::vector<uint64_t>& numInspectedItems) {
+	auto& [states, rounds] = trajectory;
+	states.assign(1, { data.itemHolders[item], data.itemWorryLevels[item] % lcm });
+	rounds.clear();
+	size_t tortoise = 0;
+	uint64_t power = 1;
+	uint64_t cycleLength = 0;
+	bool cycleFound = false;
+	while (rounds.size() < numRounds && !cycleFound) {
+		ItemState state = states.back();
+		rounds.push_back(playRound(data, state, lcm));
+		states.push_back(state);
+		++cycleLength;
+		cycleFound = state == states[tortoise];
+		if (!cycleFound && cycleLength == power) {
+			tortoise = states.size() - 1;
+			power *= 2;
+			cycleLength = 0;
+		}
+	}
 
-	return monkeyActivity[0] * monkeyActivity[1];
+	const auto addRounds = [&](uint64_t first, uint64_t last, uint64_t times) {
+		for (uint64_t round = first; round < last; ++round) {
+			for (auto inspections = rounds[round]; inspections != 0; inspections &= inspections - 1) {
+				numInspectedItems[std::countr_zero(inspections)] += times;
+			}
+		}
+	};
+	if (!cycleFound) {
+		addRounds(0, rounds.size(), 1);
+		return;
+	}
+	uint64_t cycleStart = 0;
+	while (!(states[cycleStart] == states[cycleStart + cycleLength])) {
+		++cycleStart;
+	}
+	const uint64_t roundsInCycles = numRounds - cycleStart;
+	addRounds(0, cycleStart, 1);
+	addRounds(cycleStart, cycleStart + cycleLength, roundsInCycles / cycleLength);
+	addRounds(cycleStart, cycleStart + roundsInCycles % cycleLength, 1);
 }
 
-uint64_t calculateLcm(const DataType& data) {
-	std::vector<uint64_t> divisors;
-	std::transform(data.begin(), data.end(), std::back_inserter(divisors), [](auto&& entry) {
-		return entry.second.getDivisor();
+// Items do not influence each other once worry levels are reduced modulo the lcm, so every item follows
+// its own trajectory and only the inspection counts of the workers are merged.
+std::vector<uint64_t> countInspectionsPerItem(const DataType& data, uint64_t numRounds, uint64_t lcm, size_t numThreads) {
+	const size_t numMonkeys = data.monkeys.size();
+	const size_t numItems = data.itemWorryLevels.size();
+	std::vector<uint64_t> numInspectedItems(numMonkeys, 0);
+	std::mutex mergeMutex;
+	std::atomic<size_t> nextItem{ 0 };
+	common::runOnThreads(std::min(numThreads, numItems), [&]() {
+		std::vector<uint64_t> workerInspections(numMonkeys, 0);
+		Trajectory trajectory;
+		for (size_t item = nextItem++; item < numItems; item = nextItem++) {
+			addItemInspections(data, item, numRounds, lcm, trajectory, workerInspections);
+		}
+		std::lock_guard lock(mergeMutex);
+		for (size_t monkeyIdx = 0; monkeyIdx < numMonkeys; ++monkeyIdx) {
+			numInspectedItems[monkeyIdx] += workerInspections[monkeyIdx];
+		}
 	});
-
-	uint64_t lcm = 1;
-	for (auto divisor : divisors) {
-		lcm = std::lcm(lcm, divisor);
-	}
-	
-	return lcm;
+	return numInspectedItems;
 }
 
-uint64_t partOne(DataType data) {
+uint64_t partOne(const DataType& data) {
 	constexpr int numRounds = 20;
-
-	for (int i = 0; i < numRounds; ++i) {
-		for (auto& monkey : data) {
-			monkey.second.inspectAndThrow(data);
-		}
-	}
-
-	return calculateMonkeyActivity(data);
+	return calculateMonkeyActivity(simulate(data, numRounds, [](uint64_t worryLevel) {
+		return worryLevel / 3;
+	}));
 }
 
-uint64_t partTwo(DataType data) {
+uint64_t partTwo(const DataType& data) {
 	constexpr int numRounds = 10000;
-	uint64_t lcm = calculateLcm(data);
-
-	for (int i = 0; i < numRounds; ++i) {
-		for (auto& monkey : data) {
-			monkey.second.inspectAndThrowWithLcm(data, lcm);
-		}
+	const uint64_t lcm = calculateLcm(data);
+	if (data.monkeys.size() <= MAX_TRAJECTORY_MONKEYS) {
+		return calculateMonkeyActivity(countInspectionsPerItem(data, numRounds, lcm, common::getSolverThreads()));
 	}
+	return calculateMonkeyActivity(simulate(data, numRounds, [lcm](uint64_t worryLevel) {
+		return worryLevel % lcm;
+	}));
+}
 
-	return calculateMonkeyActivity(data);
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
 }
 
+} // namespace day11
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(11, day11::parse, day11::partOne, day11::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day11::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day11::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day11::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
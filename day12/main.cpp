@@ -1,135 +1,131 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/Grid.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Solver.h"
+#include "../utils/Trace.h"
+#include <string_view>
 #include <string>
 #include <vector>
-#include <set>
+
+namespace day12 {
 
 constexpr char START_MARKER = 'S';
 constexpr char END_MARKER = 'E';
 constexpr char START_ELEWATION = 'a';
 constexpr char END_ELEWATION = 'z';
+// Lies far below every elevation, nothing can climb from the border so the search stays inside the map.
+constexpr char BORDER = '\0';
 
-using DataType = std::vector<std::vector<char>>;
-
-struct Pos {
-	int row;
-	int col;
-};
+using DataType = common::Grid<char>;
 
-struct Node {
-	int row;
-	int col;
-	int distance;
-	char elevation;
-};
+constexpr int UNREACHABLE = -1;
 
-bool operator<(const Node& n1, const Node& n2) {
-	if (n1.distance == n2.distance) {
-		return n1.col != n2.col ? n1.col < n2.col : n1.row < n2.row;
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
+	std::vector<std::string> lines;
+	for (std::string line; reader.nextLine(line);) {
+		lines.push_back(line);
 	}
-	return n1.distance < n2.distance;
+	DataType data(static_cast<int>(lines.size()), static_cast<int>(lines.front().size()), BORDER, 1);
+	for (int row = 0; row < data.getRows(); ++row) {
+		for (int col = 0; col < data.getCols(); ++col) {
+			data(row, col) = lines[row][col];
+		}
+	}
+	return data;
 }
 
-int dijkstraAlgorithm(const DataType& data, const Pos& start, const Pos& end) {
-	const int rows = data.size();
-	const int cols = data[0].size();
-	const int maxDistance = cols * rows * 10;
-
-	auto distances = std::vector<std::vector<int>>(rows, std::vector<int>(cols, maxDistance));
-	std::set<Node> nodes;
-	nodes.insert(Node{ start.row, start.col, 0, START_ELEWATION });
-	distances[start.row][start.col] = 0;
-
-	while (!nodes.empty()) {
-		auto node = *nodes.begin();
-		nodes.erase(nodes.begin());
-		auto allNeighbors = common::findNeighbors(data, node.row, node.col, 1, common::SearchPolicy::ADJACENT);
-		for (const auto& neighbor : allNeighbors) {
-			char neighborElewation = neighbor.value;
-			if (node.elevation < neighborElewation - 1 && neighborElewation != END_MARKER) {
-				continue;
-			}
-
-			if (neighborElewation == END_MARKER && node.elevation != END_ELEWATION) {
-				continue;
-			}
-
-			int nR = neighbor.row;
-			int nC = neighbor.col;
-			int nodeDistance = distances[node.row][node.col] + 1;
-			if (distances[nR][nC] > nodeDistance) {
-				auto found = nodes.find(Node{ nR, nC, distances[nR][nC] });
-				if (found != nodes.end()) {
-					nodes.erase(found);
-				}
-				nodes.insert(Node{ nR, nC, nodeDistance, neighborElewation });
-				distances[nR][nC] = nodeDistance;
+int findIndex(const DataType& data, char character) {
+	for (int row = 0; row < data.getRows(); ++row) {
+		for (int col = 0; col < data.getCols(); ++col) {
+			if (data(row, col) == character) {
+				return data.getIndex(row, col);
 			}
 		}
 	}
-
-	return distances[end.row][end.col];
+	return data.getIndex(0, 0);
 }
 
-DataType read() {
-	common::FileReader reader("input.txt");
-	DataType data;
-	for (std::string line; reader.nextLine(line);) {
-		std::vector<char> row(line.begin(), line.end());
-		data.push_back(row);
+char getElevation(char square) {
+	if (square == START_MARKER) {
+		return START_ELEWATION;
 	}
-	return data;
+	if (square == END_MARKER) {
+		return END_ELEWATION;
+	}
+	return square;
 }
 
-Pos findPos(const DataType& data, char character) {
-	const int rows = data.size();
-	const int cols = data.front().size();
-	for (int row = 0; row < rows; ++row) {
-		for (int col = 0; col < cols; ++col) {
-			if (data[row][col] == character) {
-				return { row, col };
-			}
+// Breadth first search from the end over reversed edges, so one pass yields the distance from every
+// square to the end. Squares leave the queue ordered by distance, the first one accepted by isTarget
+// is therefore the closest.
+template<typename IsTarget>
+int reverseBfs(const DataType& data, IsTarget isTarget) {
+	AOC_TRACE_SPAN("reverseBfs");
+	// Indices cover the whole padded buffer, so neighbors are plain offsets without bounds checks.
+	const int stride = data.getStride();
+	const int directions[] = { -stride, stride, -1, 1 };
+
+	std::vector<int> distances(data.getStorage().size(), UNREACHABLE);
+	// Every square is queued at most once, so a flat array with read and write positions never wraps.
+	std::vector<int> queue(data.getRows() * data.getCols());
+	size_t readPos = 0;
+	size_t writePos = 0;
+	queue[writePos++] = findIndex(data, END_MARKER);
+	distances[queue.front()] = 0;
+
+	while (readPos < writePos) {
+		AOC_TRACE_COUNT("queue pops");
+		const int index = queue[readPos++];
+		const char square = data.getCell(index);
+		if (isTarget(square)) {
+			return distances[index];
 		}
-	}
-	return { 0 , 0 };
-}
 
-std::vector<Pos> findAllPos(const DataType& data, char character) {
-	const int rows = data.size();
-	const int cols = data.front().size();
-	std::vector<Pos> matching;
-	for (int row = 0; row < rows; ++row) {
-		for (int col = 0; col < cols; ++col) {
-			if (data[row][col] == character) {
-				matching.push_back({ row, col });
+		const char elevation = getElevation(square);
+		for (const int direction : directions) {
+			const int neighborIndex = index + direction;
+			// The reversed edge exists if the neighbor is allowed to climb onto the current square.
+			if (distances[neighborIndex] != UNREACHABLE || elevation > getElevation(data.getCell(neighborIndex)) + 1) {
+				continue;
 			}
+			distances[neighborIndex] = distances[index] + 1;
+			queue[writePos++] = neighborIndex;
 		}
 	}
-	return matching;
+	return UNREACHABLE;
 }
 
 int partOne(const DataType& data) {
-	auto start = findPos(data, START_MARKER);
-	auto end = findPos(data, END_MARKER);
-	return dijkstraAlgorithm(data, start, end);
+	return reverseBfs(data, [](char square) {
+		return square == START_MARKER;
+	});
 }
 
 int partTwo(const DataType& data) {
-	auto startPoints = findAllPos(data, START_ELEWATION);
-	auto end = findPos(data, END_MARKER);
-
-	int shortestPath = 10000000;
-	for (const auto& start : startPoints) {
-		auto pathLength = dijkstraAlgorithm(data, start, end);
-		if (pathLength < shortestPath) {
-			shortestPath = pathLength;
-		}
-	}
-	return shortestPath;
+	return reverseBfs(data, [](char square) {
+		return getElevation(square) == START_ELEWATION;
+	});
+}
+
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
 }
 
+} // namespace day12
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(12, day12::parse, day12::partOne, day12::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day12::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day12::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day12::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
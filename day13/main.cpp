@@ -1,190 +1,166 @@
 #include "../common/pch.h"
-#include <string>
-#include <algorithm>
-#include <numeric>
-#include <sstream>
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Scanner.h"
+#include "../utils/Solver.h"
+#include <string_view>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
 #include <vector>
 
-int intCompare(int left, int right) {
-	if (left < right) {
-		return 1;
-	}
-	if (left > right) {
-		return -1;
+namespace day13 {
+
+// Packets are flattened into tokens, list brackets become markers and every integer is its own token.
+using Token = int32_t;
+constexpr Token LIST_OPEN = -1;
+constexpr Token LIST_CLOSE = -2;
+
+using PacketView = std::span<const Token>;
+
+constexpr std::array<Token, 5> FIRST_DIVIDER{ { LIST_OPEN, LIST_OPEN, 2, LIST_CLOSE, LIST_CLOSE } };
+constexpr std::array<Token, 5> SECOND_DIVIDER{ { LIST_OPEN, LIST_OPEN, 6, LIST_CLOSE, LIST_CLOSE } };
+
+// All packets share one token arena, a packet is the range between two consecutive offsets.
+class PacketArena {
+public:
+	void addPacket(std::string_view line) {
+		for (size_t pos = 0; pos < line.size();) {
+			const char character = line[pos];
+			if (common::Scanner::isDigit(character)) {
+				Token value = 0;
+				for (; pos < line.size() && common::Scanner::isDigit(line[pos]); ++pos) {
+					value = value * 10 + (line[pos] - '0');
+				}
+				tokens.push_back(value);
+				continue;
+			}
+			if (character == '[') {
+				tokens.push_back(LIST_OPEN);
+			} else if (character == ']') {
+				tokens.push_back(LIST_CLOSE);
+			}
+			++pos;
+		}
+		packetEnds.push_back(tokens.size());
 	}
-	return 0;
-}
 
-struct Element {
-	static Element createValueElement(int value) {
-		return Element{ true, value };
+	size_t size() const {
+		return packetEnds.size();
 	}
 
-	static Element createListElement(const std::vector<Element>& elements) {
-		return Element{ false, 0, elements };
+	PacketView getPacket(size_t index) const {
+		const size_t begin = index == 0 ? 0 : packetEnds[index - 1];
+		return PacketView(tokens).subspan(begin, packetEnds[index] - begin);
 	}
 
-	int compare(const Element& right) const {
-		// both are value
-		if (isValue && right.isValue) {
-			return intCompare(value, right.value);
-		}
+private:
+	std::vector<Token> tokens;
+	std::vector<size_t> packetEnds;
+};
 
-		// only one is value
-		if (isValue != right.isValue) {
-			if (isValue) {
-				Element meAsList = createListElement({ *this });
-				return meAsList.compare(right);
+// Returns 1 if left comes first, -1 if right does and 0 for equal packets. Both token streams are walked
+// directly. An integer compared to a list is promoted by counting the lists it virtually opened, the
+// matching closing brackets are produced once the integer has been consumed.
+int compare(PacketView left, PacketView right) {
+	size_t leftPos = 0;
+	size_t rightPos = 0;
+	int leftPromotions = 0;
+	int rightPromotions = 0;
+	int leftPendingCloses = 0;
+	int rightPendingCloses = 0;
+	while (leftPos < left.size() || rightPos < right.size()) {
+		const Token leftToken = leftPendingCloses > 0 ? LIST_CLOSE : left[leftPos];
+		const Token rightToken = rightPendingCloses > 0 ? LIST_CLOSE : right[rightPos];
+		if (leftToken == LIST_CLOSE || rightToken == LIST_CLOSE) {
+			if (leftToken != rightToken) {
+				return leftToken == LIST_CLOSE ? 1 : -1;
 			}
-			Element rightAsList = createListElement({ right });
-			return compare(rightAsList);
+			leftPendingCloses > 0 ? --leftPendingCloses : ++leftPos;
+			rightPendingCloses > 0 ? --rightPendingCloses : ++rightPos;
+			continue;
 		}
-
-		// both are list
-		const auto commonSize = std::min(elements.size(), right.elements.size());
-		for (int i = 0; i < commonSize; ++i) {
-			const auto& leftElement = elements[i];
-			const auto& rightElement = right.elements[i];
-			const auto comparisionResult = leftElement.compare(rightElement);
-			if (comparisionResult != 0) {
-				return comparisionResult;
+		if (leftToken == LIST_OPEN || rightToken == LIST_OPEN) {
+			if (leftToken == rightToken) {
+				++leftPos;
+				++rightPos;
+			} else if (leftToken == LIST_OPEN) {
+				++leftPos;
+				++rightPromotions;
+			} else {
+				++rightPos;
+				++leftPromotions;
 			}
+			continue;
 		}
-
-		return intCompare(elements.size(), right.elements.size());
-	}
-
-	bool isValue{ false };
-	int value{ 0 };
-	std::vector<Element> elements;
-	bool isDivider{ false };
-};
-
-struct PacketPair {
-	Element left;
-	Element right;
-
-	bool isInOrder() const {
-		return left.compare(right) >= 0;
-	}
-};
-
-using DataType = std::vector<PacketPair>;
-
-std::vector<std::string> splitByDelimiter(std::string line, char delimiter) {
-	int pos;
-	std::vector<std::string> result;
-	while ((pos = line.find(delimiter)) != std::string::npos && pos != line.size() - 1) {
-		result.push_back(line.substr(0, pos));
-		line = line.substr(pos + 1);
-	}
-	if (!line.empty()) {
-		result.push_back(line);
-	}
-	return result;
-}
-
-Element parseElement(const std::string& line) {
-	if (line.front() != '[') {
-		int value = -1;
-		std::istringstream stream(line);
-		stream >> value;
-		return Element::createValueElement(value);
-	}
-
-	std::string content = line.substr(1, line.size() - 2);
-	if (content.empty()) {
-		return Element::createListElement({});
-	}
-
-	std::vector<std::string> splitted = splitByDelimiter(content, ',');
-	std::vector<std::string> elementsToParse;
-	std::string elementToParse;
-	int braceCount = 0;
-	for (const auto& fragment : splitted) {
-		int startMarkers = std::count(fragment.begin(), fragment.end(), '[');
-		int endMarkers = std::count(fragment.begin(), fragment.end(), ']');
-		braceCount += startMarkers - endMarkers;
-		elementToParse += fragment;
-		
-		if (braceCount == 0) {
-			elementsToParse.push_back(elementToParse);
-			elementToParse.clear();
-		} else {
-			elementToParse += ',';
+		if (leftToken != rightToken) {
+			return leftToken < rightToken ? 1 : -1;
 		}
+		++leftPos;
+		++rightPos;
+		leftPendingCloses = std::exchange(leftPromotions, 0);
+		rightPendingCloses = std::exchange(rightPromotions, 0);
 	}
-
-	std::vector<Element> elements;
-	for (const auto& strToParse : elementsToParse) {
-		elements.push_back(parseElement(strToParse));
-	}
-	return Element::createListElement(elements);
+	return 0;
 }
 
-DataType read() {
-	common::FileReader reader("input.txt");
+using DataType = PacketArena;
+
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
-	for (std::string line; reader.nextLine(line);) {
-		if (line.empty()) {
-			continue;
+	for (std::string_view line; reader.nextLine(line);) {
+		if (!line.empty()) {
+			data.addPacket(line);
 		}
-
-		PacketPair pair;
-		pair.left = parseElement(line);
-		pair.right = parseElement(reader.nextLine());
-		data.push_back(std::move(pair));
 	}
 	return data;
 }
 
 int partOne(const DataType& data) {
 	int indicesSum = 0;
-	for (int i = 0; i < data.size(); ++i) {
-		const auto& pair = data[i];
-		if (pair.isInOrder()) {
-			indicesSum += i + 1;
+	for (size_t i = 0; i + 1 < data.size(); i += 2) {
+		if (compare(data.getPacket(i), data.getPacket(i + 1)) >= 0) {
+			indicesSum += static_cast<int>(i / 2 + 1);
 		}
 	}
 	return indicesSum;
 }
 
 int partTwo(const DataType& data) {
-	std::vector<Element> elements;
-	elements.reserve(data.size() * 2 + 2);
-	for (const auto& pair : data) {
-		elements.push_back(pair.left);
-		elements.push_back(pair.right);
+	// Only the positions of the dividers matter, so counting the packets before them replaces sorting.
+	size_t firstDividerPos = 1;
+	size_t secondDividerPos = 2;
+	for (size_t i = 0; i < data.size(); ++i) {
+		const auto packet = data.getPacket(i);
+		if (compare(packet, FIRST_DIVIDER) > 0) {
+			++firstDividerPos;
+			++secondDividerPos;
+		} else if (compare(packet, SECOND_DIVIDER) > 0) {
+			++secondDividerPos;
+		}
 	}
+	return static_cast<int>(firstDividerPos * secondDividerPos);
+}
 
-	auto divider1 = parseElement("[[2]]");
-	divider1.isDivider = true;
-	elements.push_back(divider1);
-
-	auto divider2 = parseElement("[[6]]");
-	divider2.isDivider = true;
-	elements.push_back(divider2);
-
-	std::sort(elements.begin(), elements.end(), [](auto&& left, auto&& right) {
-		return left.compare(right) > 0;
-	});
-
-	auto divider1Iterator = std::find_if(elements.begin(), elements.end(), [](auto&& element) {
-		return element.isDivider;
-	});
-
-	auto divider2Iterator = std::find_if(std::next(divider1Iterator), elements.end(), [](auto&& element) {
-		return element.isDivider;
-	});
-
-	auto divider1Pos = std::distance(elements.begin(), divider1Iterator) + 1;
-	auto divider2Pos = std::distance(elements.begin(), divider2Iterator) + 1;
-	return divider1Pos * divider2Pos;
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
 }
 
+} // namespace day13
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(13, day13::parse, day13::partOne, day13::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day13::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day13::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day13::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
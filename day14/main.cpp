@@ -1,11 +1,19 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Scanner.h"
+#include "../utils/Solver.h"
+#include "../utils/Trace.h"
 #include <string>
 #include <algorithm>
-#include <sstream>
+#include <string_view>
 #include <vector>
 #include <unordered_set>
 #include <array>
 
+namespace day14 {
+
 using Point = common::Point<int>;
 
 struct Line {
@@ -14,33 +22,15 @@ struct Line {
 
 using DataType = std::vector<Line>;
 
-std::vector<std::string> splitByDelimiter(std::string line, const std::string& delimiter) {
-	int pos;
-	std::vector<std::string> result;
-	while ((pos = line.find(delimiter)) != std::string::npos && pos != line.size() - delimiter.size()) {
-		result.push_back(line.substr(0, pos));
-		line = line.substr(pos + delimiter.size());
-	}
-	if (!line.empty()) {
-		result.push_back(line);
-	}
-	return result;
-}
-
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
-	for (std::string line; reader.nextLine(line);) {
-		auto pointsToParse = splitByDelimiter(line, " -> ");
+	for (std::string_view line; reader.nextLine(line);) {
+		common::Scanner scanner(line);
 		Line parsedLine;
-		std::transform(pointsToParse.begin(), pointsToParse.end(), std::back_inserter(parsedLine.points), [](auto&& pointToParse) {
-			std::istringstream stream(pointToParse);
-			Point point;
-			stream >> point.x;
-			stream.ignore();
-			stream >> point.y;
-			return point;
-		});
+		for (Point point; scanner.tryNextInt(point.x) && scanner.tryNextInt(point.y);) {
+			parsedLine.points.push_back(point);
+		}
 		data.push_back(parsedLine);
 	}
 	return data;
@@ -74,6 +64,7 @@ void fillMap(std::unordered_set<Point>& map, const Line& line) {
 bool simulateSand(std::unordered_set<Point>& occupiedPlaces, int maxY) {
 	Point sand{ 500, 0 };
 	while (sand.y < maxY) {
+		AOC_TRACE_COUNT("simulateSand steps");
 		int newYLevel = sand.y + 1;
 		const std::array<Point, 3> possibilities{ { {sand.x, newYLevel}, {sand.x - 1, newYLevel}, {sand.x + 1, newYLevel} } };
 		bool moved = false;
@@ -100,6 +91,7 @@ bool simulateSandWithFloor(std::unordered_set<Point>& occupiedPlaces, int maxY)
 
 	const auto floorLevel = maxY + 2;
 	while (sand.y < floorLevel - 1) {
+		AOC_TRACE_COUNT("simulateSandWithFloor steps");
 		auto newYLevel = sand.y + 1;
 		const std::array<Point, 3> possibilities{ { {sand.x, newYLevel}, {sand.x - 1, newYLevel}, {sand.x + 1, newYLevel} } };
 		bool moved = false;
@@ -160,9 +152,22 @@ int partTwo(const DataType& data) {
 	return restedSand;
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day14
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(14, day14::parse, day14::partOne, day14::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day14::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day14::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day14::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,10 +1,18 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Scanner.h"
+#include "../utils/Solver.h"
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <numeric>
 #include <vector>
 #include <unordered_set>
 
+namespace day15 {
+
 using Point = common::Point<int>;
 
 struct Measurement {
@@ -19,27 +27,16 @@ int manhattanDistance(const Point& left, const Point& right) {
 	return abs(left.x - right.x) + abs(left.y - right.y);
 }
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
-	for (std::string line; reader.nextLine(line);) {
+	for (std::string_view line; reader.nextLine(line);) {
+		common::Scanner scanner(line);
 		Measurement meas;
-		auto eqPos = line.find('=');
-		line = line.substr(eqPos + 1);
-		meas.sensor.x = std::stoi(line);
-
-		eqPos = line.find('=');
-		line = line.substr(eqPos + 1);
-		meas.sensor.y = std::stoi(line);
-
-		eqPos = line.find('=');
-		line = line.substr(eqPos + 1);
-		meas.beacon.x = std::stoi(line);
-
-		eqPos = line.find('=');
-		line = line.substr(eqPos + 1);
-		meas.beacon.y = std::stoi(line);
-
+		meas.sensor.x = scanner.nextSignedInt();
+		meas.sensor.y = scanner.nextSignedInt();
+		meas.beacon.x = scanner.nextSignedInt();
+		meas.beacon.y = scanner.nextSignedInt();
 		meas.distance = manhattanDistance(meas.sensor, meas.beacon);
 		data.push_back(meas);
 	}
@@ -207,9 +204,22 @@ uint64_t partTwo(const DataType& data) {
 	return -1;
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day15
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(15, day15::parse, day15::partOne, day15::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day15::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day15::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day15::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
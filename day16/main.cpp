@@ -1,4 +1,10 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Solver.h"
+#include "../utils/Trace.h"
+#include <string_view>
 #include <string>
 #include <algorithm>
 #include <numeric>
@@ -8,6 +14,8 @@
 #include <set>
 #include <unordered_set>
 
+namespace day16 {
+
 struct Valve {
 	int id;
 	int flowRate{ 0 };
@@ -20,8 +28,8 @@ int strToId(const std::string& str) {
 	return str[0] * 100 + str[1];
 }
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
 	for (std::string line; reader.nextLine(line);) {
 		std::string id = line.substr(line.find("Valve") + 6, 2);
@@ -201,6 +209,7 @@ public:
 	}
 
 	void trawerse(int currentScore, int minutesLeft, const int& valveId, std::set<int> openedValves) {
+		AOC_TRACE_COUNT("trawerse nodes");
 		auto& valve = data[valveId];
 
 		if (valve.flowRate > 0) {
@@ -265,6 +274,7 @@ public:
 	}
 
 	void nextMinuteWithElephant(int currentScore, int timePassed, std::unordered_set<int> notOpenedValves, Actor me, Actor elephant) {
+		AOC_TRACE_COUNT("nextMinuteWithElephant nodes");
 		if (timePassed >= totalTime) {
 			addNewScore(currentScore);
 			return;
@@ -347,9 +357,22 @@ int partTwo(DataType data) {
 	return trawerse.getMaxScore();
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day16
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(16, day16::parse, day16::partOne, day16::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day16::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day16::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day16::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,4 +1,10 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Solver.h"
+#include "../utils/Trace.h"
+#include <string_view>
 #include <cstdint>
 #include <string>
 #include <algorithm>
@@ -7,6 +13,8 @@
 #include <deque>
 #include <array>
 
+namespace day17 {
+
 using Point = common::Point<int>;
 using common::Dir;
 using DataType = std::vector<Dir>;
@@ -50,8 +58,8 @@ bool operator==(const Dir& left, const Dir& right) {
 	return left.x == right.x && left.y == right.y;
 }
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
 	std::string line = reader.nextLine();
 	std::transform(line.begin(), line.end(), std::back_inserter(data), [](auto&& character) {
@@ -85,6 +93,7 @@ public:
 	}
 
 	bool canBeMoved(const Dir& dir) const {
+		AOC_TRACE_COUNT("canBeMoved checks");
 		if (dir == Dir::BOTTOM) {
 			return checkBottom();
 		}
@@ -319,9 +328,22 @@ uint64_t partTwo(const DataType& moveArray) {
 	return maxTowerHeight + scoreBase;
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day17
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(17, day17::parse, day17::partOne, day17::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day17::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day17::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day17::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,4 +1,9 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Solver.h"
+#include <string_view>
 #include <string>
 #include <algorithm>
 #include <numeric>
@@ -7,11 +12,13 @@
 #include <unordered_set>
 #include <array>
 
+namespace day18 {
+
 using Cube = common::Vec3<int>;
 using DataType = std::vector<Cube>;
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
 	for (std::string line; reader.nextLine(line);) {
 		auto cube = common::AggregateFactory<Cube>{','}.create<int, int, int>(line);
@@ -162,9 +169,22 @@ int partTwo(const DataType& data) {
 	return exposedSurfaceCount;
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day18
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(18, day18::parse, day18::partOne, day18::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day18::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day18::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day18::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,14 +1,21 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Solver.h"
+#include <string_view>
 #include <cstdint>
 #include <string>
 #include <algorithm>
 #include <vector>
 #include <list>
 
+namespace day20 {
+
 using DataType = std::vector<int64_t>;
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
 	for (std::string line; reader.nextLine(line);) {
 		data.push_back(std::stoi(line));
@@ -84,9 +91,22 @@ int64_t partTwo(const DataType& data) {
 	return sumKeys(values);
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day20
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(20, day20::parse, day20::partOne, day20::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day20::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day20::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day20::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
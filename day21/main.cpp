@@ -1,10 +1,17 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Scanner.h"
+#include "../utils/Solver.h"
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include <vector>
 #include <unordered_map>
-#include <regex>
+
+namespace day21 {
 
 enum class Action {
 	ADD,
@@ -31,41 +38,41 @@ using DataType = std::unordered_map <std::string, Monkey>;
 static const std::string ROOT_NAME = "root";
 static const std::string HUMAN_NAME = "humn";
 
-Action strToAction(const std::string& str) {
-	if (str == "*") {
+Action symbolToAction(char symbol) {
+	if (symbol == '*') {
 		return Action::MULTIPLY;
 	}
-	if (str == "-") {
+	if (symbol == '-') {
 		return Action::SUBTRACT;
 	}
-	if (str == "/") {
+	if (symbol == '/') {
 		return Action::DIVIDE;
 	}
 	return Action::ADD;
 }
 
-DataType read() {
-	common::FileReader reader("input.txt");
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
 	DataType data;
-	for (std::string line; reader.nextLine(line);) {
-		std::regex valuePattern("(\\w+):\\s(\\d+)");
-		std::smatch match;
-		if (std::regex_match(line, match, valuePattern)) {
-			Monkey monkey;
-			monkey.isYellingValue = true;
-			monkey.name = match[1];
-			monkey.value = std::stoi(match[2]);
-			data.insert({ monkey.name, monkey });
+	for (std::string_view line; reader.nextLine(line);) {
+		if (line.empty()) {
 			continue;
 		}
 
-		std::regex actionPattern("(\\w+):\\s(\\w+)\\s([+-/*])\\s(\\w+)");
-		if(std::regex_match(line, match, actionPattern)) {
-			Monkey monkey;
-			monkey.name = match[1];
-			monkey.operation = Operation{ match[2], match[4], strToAction(match[3]) };
-			data.insert({ monkey.name, monkey });
+		common::Scanner scanner(line);
+		Monkey monkey;
+		monkey.name = scanner.nextWord();
+		scanner.skip(": ");
+		if (common::Scanner::isDigit(scanner.peek())) {
+			monkey.isYellingValue = true;
+			monkey.value = scanner.nextInt<int64_t>();
+		} else {
+			const auto left = scanner.nextWord();
+			const auto action = symbolToAction(scanner.nextSymbol());
+			const auto right = scanner.nextWord();
+			monkey.operation = Operation{ std::string(left), std::string(right), action };
 		}
+		data.insert({ monkey.name, monkey });
 	}
 	return data;
 }
@@ -186,9 +193,22 @@ int64_t partTwo(const DataType& monkeys) {
 	return targetMonkeyExpectedResult;
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day21
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(21, day21::parse, day21::partOne, day21::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day21::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day21::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day21::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,13 +1,21 @@
 #include "../common/pch.h"
+#include "../utils/Benchmark.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/Grid.h"
+#include "../utils/MappedFileReader.h"
+#include "../utils/Scanner.h"
+#include "../utils/Solver.h"
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include <numeric>
 #include <utility>
 #include <vector>
 #include <array>
 #include <cmath>
-#include <regex>
+
+namespace day22 {
 
 using common::Dir;
 using Point = common::Point<int>;
@@ -35,7 +43,10 @@ struct Connection {
 
 constexpr int GRID_SIZE = 4;
 
-using MapType = std::vector<std::string>;
+constexpr char SYMBOL_VOID = ' ';
+
+// Rows shorter than the widest one are padded with SYMBOL_VOID.
+using MapType = common::Grid<char>;
 using CommandList = std::vector<Command>;
 using GridType = std::vector<std::vector<GridValue>>;
 using DataType = std::pair<MapType, CommandList>;
@@ -47,39 +58,42 @@ Dir parseDir(char character) {
 	return Dir::LEFT;
 }
 
-CommandList parseCommands(const std::string& input) {
-	std::regex pattern("([RL]*)(\\d+)");
-	std::sregex_iterator start(input.begin(), input.end(), pattern);
-	std::sregex_iterator end;
-
+CommandList parseCommands(std::string_view input) {
+	common::Scanner scanner(input);
 	CommandList commands;
-	for (auto it = start; it != end; ++it) {
-		const auto dirStr = it->str(1);
-		if (!dirStr.empty()) {
+	while (!scanner.atEnd()) {
+		if (common::Scanner::isDigit(scanner.peek())) {
 			Command cmd;
-			cmd.isDirChange = true;
-			cmd.dir = parseDir(dirStr.front());
+			cmd.value = scanner.nextInt();
 			commands.push_back(cmd);
+			continue;
 		}
 
-		const auto valueStr = it->str(2);
-		if (!valueStr.empty()) {
+		const char symbol = scanner.nextSymbol();
+		if (symbol == 'R' || symbol == 'L') {
 			Command cmd;
-			cmd.value = std::stoi(valueStr);
+			cmd.isDirChange = true;
+			cmd.dir = parseDir(symbol);
 			commands.push_back(cmd);
 		}
 	}
 	return commands;
 }
 
-DataType read() {
-	common::FileReader reader("input.txt");
-	MapType map;
+DataType parse(std::string_view input) {
+	common::LineReader reader(input);
+	std::vector<std::string> lines;
+	size_t width = 0;
 	for (std::string line; reader.nextLine(line);) {
 		if (line.empty()) {
 			break;
 		}
-		map.push_back(line);
+		width = std::max(width, line.size());
+		lines.push_back(line);
+	}
+	MapType map(static_cast<int>(lines.size()), static_cast<int>(width), SYMBOL_VOID);
+	for (int rowIdx = 0; rowIdx < map.getRows(); ++rowIdx) {
+		std::copy(lines[rowIdx].begin(), lines[rowIdx].end(), map[rowIdx].begin());
 	}
 	CommandList commands = parseCommands(reader.nextLine());
 	DataType data{ std::move(map), std::move(commands) };
@@ -114,20 +128,21 @@ public:
 
 private:
 	void calculateRowOffsets() {
-		for (const auto& row : map) {
-			auto offset = row.find_first_not_of(' ');
-			rowOffsets.push_back(offset);
+		for (int rowIdx = 0; rowIdx < map.getRows(); ++rowIdx) {
+			const auto row = map[rowIdx];
+			const auto isTile = [](char symbol) { return symbol != SYMBOL_VOID; };
+			rowOffsets.push_back(std::find_if(row.begin(), row.end(), isTile) - row.begin());
+			rowEnds.push_back(row.rend() - std::find_if(row.rbegin(), row.rend(), isTile));
 		}
 	}
 
 	void calculateColumnRanges() {
-		const int maxRange = map.size();
+		const int maxRange = map.getRows();
 		const int minRange = 0;
 		const std::pair<int, int> initialRange(maxRange, minRange);
-		for (int rowIdx = 0; rowIdx < map.size(); ++rowIdx) {
+		for (int rowIdx = 0; rowIdx < map.getRows(); ++rowIdx) {
 			auto offset = rowOffsets[rowIdx];
-			const auto& row = map[rowIdx];
-			for (int columnIdx = offset; columnIdx < row.size(); ++columnIdx) {
+			for (int columnIdx = offset; columnIdx < rowEnds[rowIdx]; ++columnIdx) {
 				if (columnIdx >= columnRanges.size()) {
 					columnRanges.resize(columnIdx + 1, initialRange);
 				}
@@ -171,20 +186,20 @@ private:
 			}
 		}
 
-		const auto& newRow = map[newPos.y];
 		const auto& rowOffset = rowOffsets[newPos.y];
+		const auto& rowEnd = rowEnds[newPos.y];
 
 		if (currentDir.x != 0) {
 			if (newPos.x < rowOffset) {
-				newPos.x = newRow.size() - 1;
+				newPos.x = rowEnd - 1;
 			}
 
-			if (newPos.x >= newRow.size()) {
+			if (newPos.x >= rowEnd) {
 				newPos.x = rowOffset;
 			}
 		}
 
-		if (newRow[newPos.x] == '#') {
+		if (map(newPos.y, newPos.x) == '#') {
 			return false;
 		}
 		currentPos = newPos;
@@ -194,6 +209,7 @@ private:
 	const MapType& map;
 	Dir currentDir;
 	std::vector<int> rowOffsets;
+	std::vector<int> rowEnds;
 	std::vector<std::pair<int ,int>> columnRanges;
 	Point currentPos;
 };
@@ -227,20 +243,21 @@ public:
 
 private:
 	void calculateRowOffsets() {
-		for (const auto& row : map) {
-			auto offset = row.find_first_not_of(' ');
-			rowOffsets.push_back(offset);
+		for (int rowIdx = 0; rowIdx < map.getRows(); ++rowIdx) {
+			const auto row = map[rowIdx];
+			const auto isTile = [](char symbol) { return symbol != SYMBOL_VOID; };
+			rowOffsets.push_back(std::find_if(row.begin(), row.end(), isTile) - row.begin());
+			rowEnds.push_back(row.rend() - std::find_if(row.rbegin(), row.rend(), isTile));
 		}
 	}
 
 	void calculateColumnRanges() {
-		const int maxRange = map.size();
+		const int maxRange = map.getRows();
 		const int minRange = 0;
 		const std::pair<int, int> initialRange(maxRange, minRange);
-		for (int rowIdx = 0; rowIdx < map.size(); ++rowIdx) {
+		for (int rowIdx = 0; rowIdx < map.getRows(); ++rowIdx) {
 			auto offset = rowOffsets[rowIdx];
-			const auto& row = map[rowIdx];
-			for (int columnIdx = offset; columnIdx < row.size(); ++columnIdx) {
+			for (int columnIdx = offset; columnIdx < rowEnds[rowIdx]; ++columnIdx) {
 				if (columnIdx >= columnRanges.size()) {
 					columnRanges.resize(columnIdx + 1, initialRange);
 				}
@@ -324,16 +341,15 @@ private:
 		}
 
 		if (currentDir.x != 0) {
-			const auto& row = map[newPos.y];
 			const auto& rowOffset = rowOffsets[newPos.y];
-			if (newPos.x < rowOffset || newPos.x >= row.size()) {
+			if (newPos.x < rowOffset || newPos.x >= rowEnds[newPos.y]) {
 				newDir = target->dir.opposite();
 				auto yOffset = newPos.y - currentTilePos.y * edgeLength;
 				newPos = calculatePosOnANewTile(target.value(), yOffset, currentEndPoint.dir);
 			}
 		}
 		
-		if (map[newPos.y][newPos.x] == '#') {
+		if (map(newPos.y, newPos.x) == '#') {
 			return false;
 		}
 
@@ -357,6 +373,7 @@ private:
 	int edgeLength;
 	Dir currentDir;
 	std::vector<int> rowOffsets;
+	std::vector<int> rowEnds;
 	std::vector<std::pair<int, int>> columnRanges;
 	Point currentPos;
 };
@@ -382,10 +399,9 @@ int calculateScore(const Point& finalPos, const Dir& finalDir) {
 }
 
 int calculateEdgeLength(const MapType& map) {
-	auto surfaceArea = std::accumulate(map.begin(), map.end(), 0, [](auto&& sum, auto&& row) {
-		std::string charactersOnly = row;
-		common::replaceAll(charactersOnly, " ", "");
-		return sum + charactersOnly.size();
+	const auto cells = map.getStorage();
+	auto surfaceArea = std::count_if(cells.begin(), cells.end(), [](char symbol) {
+		return symbol != SYMBOL_VOID;
 	});
 	return sqrt(surfaceArea / 6);
 }
@@ -396,11 +412,7 @@ GridType placeTilesOnGrid(const MapType& map, int edgeLength) {
 		for (int x = 0; x < GRID_SIZE; ++x) {
 			auto realY = y * edgeLength + edgeLength / 2;
 			auto realX = x * edgeLength + edgeLength / 2;
-			if (realY >= map.size()) {
-				continue;
-			}
-			auto row = map[realY];
-			if (realX >= row.size() || row[realX] == ' ') {
+			if (!map.contains(realY, realX) || map(realY, realX) == SYMBOL_VOID) {
 				continue;
 			}
 			grid[y][x] = GridValue::TILE;
@@ -611,9 +623,22 @@ int partTwo(const DataType& data) {
 	return calculateScore(walker.getPosition(), walker.getDirection());
 }
 
+const common::Solver& getSolver() {
+	static const common::DaySolver solver(parse, partOne, partTwo);
+	return solver;
+}
+
+} // namespace day22
+
+#if defined(AOC_RUNNER)
+static const common::DayRegistration registration(22, day22::parse, day22::partOne, day22::partTwo);
+#elif !defined(AOC_LIBRARY)
 int main(int argc, char** argv) {
-	const auto data = read();
-	common::measureAndPrint("Part 1", partOne, data);
-	common::measureAndPrint("Part 2", partTwo, data);
+	const common::MappedFile input("input.txt");
+	const auto data = day22::parse(input.getContent());
+	const auto benchmark = common::BenchmarkOptions::fromArgs(argc, argv);
+	common::measureAndPrint("Part 1", day22::partOne, data, benchmark);
+	common::measureAndPrint("Part 2", day22::partTwo, data, benchmark);
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,664 @@
+#include "Generators.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace generator {
+
+namespace {
+
+constexpr std::string_view lowercaseLetters = "abcdefghijklmnopqrstuvwxyz";
+constexpr std::string_view uppercaseLetters = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+char randomLetter(Random& random, std::string_view letters) {
+	return letters[random.between(0, static_cast<int64_t>(letters.size()) - 1)];
+}
+
+// Size: number of elves.
+void generateDay01(std::ostream& output, Random& random, int64_t size) {
+	for (int64_t elf = 0; elf < size; ++elf) {
+		const auto numItems = random.between(1, 15);
+		for (int64_t item = 0; item < numItems; ++item) {
+			output << random.between(1000, 60000) << '\n';
+		}
+		output << '\n';
+	}
+}
+
+// Size: number of rounds.
+void generateDay02(std::ostream& output, Random& random, int64_t size) {
+	for (int64_t round = 0; round < size; ++round) {
+		output << static_cast<char>('A' + random.between(0, 2)) << ' ' << static_cast<char>('X' + random.between(0, 2)) << '\n';
+	}
+}
+
+// Size: number of rucksacks, rounded up to whole groups of three. Both compartments of a rucksack
+// share exactly one item and the three rucksacks of a group share exactly one badge.
+void generateDay03(std::ostream& output, Random& random, int64_t size) {
+	constexpr int groupSize = 3;
+	constexpr int privateItems = 17;
+	std::string items;
+	items.append(lowercaseLetters).append(uppercaseLetters);
+
+	for (int64_t group = 0; group < (size + groupSize - 1) / groupSize; ++group) {
+		random.shuffle(items);
+		const char badge = items.back();
+		for (int rucksack = 0; rucksack < groupSize; ++rucksack) {
+			const std::string_view ownItems = std::string_view(items).substr(rucksack * privateItems, privateItems);
+			const char sharedItem = ownItems[0];
+			const auto leftItems = ownItems.substr(1, privateItems / 2);
+			const auto rightItems = ownItems.substr(1 + privateItems / 2);
+
+			const auto compartmentSize = random.between(4, 16);
+			std::string left{ sharedItem, badge };
+			std::string right{ sharedItem };
+			while (static_cast<int64_t>(left.size()) < compartmentSize) {
+				left += randomLetter(random, leftItems);
+			}
+			while (static_cast<int64_t>(right.size()) < compartmentSize) {
+				right += randomLetter(random, rightItems);
+			}
+			random.shuffle(left);
+			random.shuffle(right);
+			output << left << right << '\n';
+		}
+	}
+}
+
+// Size: number of section assignment pairs.
+void generateDay04(std::ostream& output, Random& random, int64_t size) {
+	for (int64_t pair = 0; pair < size; ++pair) {
+		const auto firstBegin = random.between(1, 99);
+		const auto firstEnd = random.between(firstBegin, 99);
+		const auto secondBegin = random.between(1, 99);
+		const auto secondEnd = random.between(secondBegin, 99);
+		output << firstBegin << '-' << firstEnd << ',' << secondBegin << '-' << secondEnd << '\n';
+	}
+}
+
+// Size: number of crates and number of moves. Moves never take more crates than the source holds.
+void generateDay05(std::ostream& output, Random& random, int64_t size) {
+	constexpr int numStacks = 9;
+	std::array<std::string, numStacks> stacks;
+	for (int64_t crate = 0; crate < size; ++crate) {
+		stacks[random.between(0, numStacks - 1)] += randomLetter(random, uppercaseLetters);
+	}
+
+	size_t maxHeight = 0;
+	for (const auto& stack : stacks) {
+		maxHeight = std::max(maxHeight, stack.size());
+	}
+	for (size_t row = maxHeight; row-- > 0;) {
+		std::string line;
+		for (int stack = 0; stack < numStacks; ++stack) {
+			if (stack > 0) {
+				line += ' ';
+			}
+			if (row < stacks[stack].size()) {
+				line.append({ '[', stacks[stack][row], ']' });
+			} else {
+				line += "   ";
+			}
+		}
+		output << line << '\n';
+	}
+	for (int stack = 1; stack <= numStacks; ++stack) {
+		output << ' ' << stack << (stack < numStacks ? "  " : "\n");
+	}
+	output << '\n';
+
+	const auto maxQuantity = std::max<int64_t>(50, static_cast<int64_t>(std::sqrt(static_cast<double>(size))));
+	std::array<int64_t, numStacks> heights;
+	std::transform(stacks.begin(), stacks.end(), heights.begin(), [](const auto& stack) {
+		return static_cast<int64_t>(stack.size());
+	});
+	for (int64_t move = 0; move < size; ++move) {
+		int64_t src = random.between(0, numStacks - 1);
+		while (heights[src] == 0) {
+			src = (src + 1) % numStacks;
+		}
+		auto tgt = random.between(0, numStacks - 2);
+		if (tgt >= src) {
+			++tgt;
+		}
+		const auto quantity = random.between(1, std::min(heights[src], maxQuantity));
+		heights[src] -= quantity;
+		heights[tgt] += quantity;
+		output << "move " << quantity << " from " << src + 1 << " to " << tgt + 1 << '\n';
+	}
+}
+
+// Size: length of the datastream. Both markers only appear at the very end, so the whole stream is scanned.
+void generateDay06(std::ostream& output, Random& random, int64_t size) {
+	constexpr int messageMarkerLength = 14;
+	std::string stream;
+	stream.reserve(size);
+	while (static_cast<int64_t>(stream.size()) < size - messageMarkerLength) {
+		stream += randomLetter(random, "abc");
+	}
+	std::string marker(lowercaseLetters.substr(3));
+	random.shuffle(marker);
+	stream.append(marker, 0, messageMarkerLength);
+	output << stream << '\n';
+}
+
+// Size: number of files and directories. The total used space is kept around 50000000.
+void generateDay07(std::ostream& output, Random& random, int64_t size) {
+	struct Directory {
+		std::vector<int64_t> subdirectories;
+		std::vector<int64_t> files;
+	};
+	std::vector<Directory> directories(1);
+	int64_t numFiles = 0;
+	for (int64_t entry = 1; entry < size; ++entry) {
+		const auto parent = random.between(0, static_cast<int64_t>(directories.size()) - 1);
+		if (random.chance(20)) {
+			directories[parent].subdirectories.push_back(static_cast<int64_t>(directories.size()));
+			directories.emplace_back();
+		} else {
+			directories[parent].files.push_back(numFiles++);
+		}
+	}
+
+	const auto averageFileSize = std::max<int64_t>(2, 50000000 / std::max<int64_t>(1, numFiles));
+	output << "$ cd /\n";
+	// Explicit stack instead of recursion, the directory tree can get deep for large sizes.
+	std::vector<std::pair<int64_t, size_t>> path{ { 0, 0 } };
+	output << "$ ls\n";
+	const auto listDirectory = [&](int64_t directoryId) {
+		for (const auto subdirectory : directories[directoryId].subdirectories) {
+			output << "dir d" << subdirectory << '\n';
+		}
+		for (const auto file : directories[directoryId].files) {
+			output << random.between(1, averageFileSize * 2 - 1) << " f" << file << ".txt\n";
+		}
+	};
+	listDirectory(0);
+	while (!path.empty()) {
+		auto& [directoryId, nextChild] = path.back();
+		const auto& subdirectories = directories[directoryId].subdirectories;
+		if (nextChild == subdirectories.size()) {
+			path.pop_back();
+			if (!path.empty()) {
+				output << "$ cd ..\n";
+			}
+			continue;
+		}
+		const auto childId = subdirectories[nextChild++];
+		output << "$ cd d" << childId << "\n$ ls\n";
+		listDirectory(childId);
+		path.push_back({ childId, 0 });
+	}
+}
+
+// Size: width and height of the tree grid.
+void generateDay08(std::ostream& output, Random& random, int64_t size) {
+	std::string row(size, '0');
+	for (int64_t y = 0; y < size; ++y) {
+		std::generate(row.begin(), row.end(), [&random]() {
+			return static_cast<char>('0' + random.between(0, 9));
+		});
+		output << row << '\n';
+	}
+}
+
+// Size: number of head motions.
+void generateDay09(std::ostream& output, Random& random, int64_t size) {
+	for (int64_t motion = 0; motion < size; ++motion) {
+		output << randomLetter(random, "UDLR") << ' ' << random.between(1, 20) << '\n';
+	}
+}
+
+// Size: number of instructions, at least enough to draw the whole CRT. X stays within the screen.
+void generateDay10(std::ostream& output, Random& random, int64_t size) {
+	constexpr int64_t minInstructions = 241;
+	int64_t x = 1;
+	for (int64_t instruction = 0; instruction < std::max(size, minInstructions); ++instruction) {
+		if (random.chance(40)) {
+			output << "noop\n";
+			continue;
+		}
+		const auto value = std::clamp<int64_t>(random.between(-10, 10), -5 - x, 45 - x);
+		x += value;
+		output << "addx " << value << '\n';
+	}
+}
+
+// Size: total number of items, spread over eight monkeys.
+void generateDay11(std::ostream& output, Random& random, int64_t size) {
+	constexpr int numMonkeys = 8;
+	std::array<int, numMonkeys> divisors{ 2, 3, 5, 7, 11, 13, 17, 19 };
+	random.shuffle(divisors);
+	std::array<std::vector<int64_t>, numMonkeys> items;
+	for (int64_t item = 0; item < size; ++item) {
+		const auto owner = item < numMonkeys ? item : random.between(0, numMonkeys - 1);
+		items[owner].push_back(random.between(50, 99));
+	}
+
+	const auto squaringMonkey = random.between(0, numMonkeys - 1);
+	for (int monkey = 0; monkey < numMonkeys; ++monkey) {
+		output << "Monkey " << monkey << ":\n  Starting items:";
+		for (size_t i = 0; i < items[monkey].size(); ++i) {
+			output << (i == 0 ? " " : ", ") << items[monkey][i];
+		}
+		output << "\n  Operation: new = old ";
+		if (monkey == squaringMonkey) {
+			output << "* old\n";
+		} else if (random.chance(30)) {
+			output << "* " << random.between(2, 19) << '\n';
+		} else {
+			output << "+ " << random.between(1, 8) << '\n';
+		}
+		output << "  Test: divisible by " << divisors[monkey] << '\n';
+
+		auto trueTarget = random.between(0, numMonkeys - 2);
+		trueTarget += trueTarget >= monkey ? 1 : 0;
+		auto falseTarget = random.between(0, numMonkeys - 2);
+		falseTarget += falseTarget >= monkey ? 1 : 0;
+		output << "    If true: throw to monkey " << trueTarget << '\n';
+		output << "    If false: throw to monkey " << falseTarget << "\n\n";
+	}
+}
+
+// Size: width and height of the heightmap. The terrain rises from the top left start to the bottom
+// right end, random dips turn it into a maze while the left column and the bottom row stay climbable.
+void generateDay12(std::ostream& output, Random& random, int64_t size) {
+	size = std::max<int64_t>(size, 40);
+	constexpr int maxElevation = 25;
+	for (int64_t row = 0; row < size; ++row) {
+		std::string line(size, 'a');
+		for (int64_t col = 0; col < size; ++col) {
+			auto elevation = std::min<int64_t>(maxElevation, (row + col) * (maxElevation + 1) / (2 * size));
+			const bool isGuaranteedPath = col == 0 || row == size - 1;
+			if (!isGuaranteedPath && elevation > 0 && random.chance(30)) {
+				elevation -= random.between(1, elevation);
+			}
+			line[col] = static_cast<char>('a' + elevation);
+		}
+		if (row == 0) {
+			line.front() = 'S';
+		}
+		if (row == size - 1) {
+			line.back() = 'E';
+		}
+		output << line << '\n';
+	}
+}
+
+void writePacket(std::ostream& output, Random& random, int depth) {
+	output << '[';
+	const auto numElements = random.between(0, 5);
+	for (int64_t element = 0; element < numElements; ++element) {
+		if (element > 0) {
+			output << ',';
+		}
+		if (depth < 4 && random.chance(25)) {
+			writePacket(output, random, depth + 1);
+		} else {
+			output << random.between(0, 10);
+		}
+	}
+	output << ']';
+}
+
+// Lists nested around a single 2 or 6 compare equal to a divider packet, which would leave the position
+// of the divider in part two up to how ties are ordered.
+bool equalsDivider(std::string_view packet) {
+	const auto numberPos = packet.find_first_not_of('[');
+	const auto closingPos = packet.find_first_of(']', numberPos);
+	const auto number = packet.substr(numberPos, closingPos - numberPos);
+	return numberPos > 0 && (number == "2" || number == "6") && packet.find_first_not_of(']', closingPos) == std::string_view::npos;
+}
+
+void writePacketOtherThanDividers(std::ostream& output, Random& random) {
+	std::ostringstream packet;
+	do {
+		packet.str({});
+		writePacket(packet, random, 0);
+	} while (equalsDivider(packet.view()));
+	output << packet.view();
+}
+
+// Size: number of packet pairs.
+void generateDay13(std::ostream& output, Random& random, int64_t size) {
+	for (int64_t pair = 0; pair < size; ++pair) {
+		if (pair > 0) {
+			output << '\n';
+		}
+		writePacketOtherThanDividers(output, random);
+		output << '\n';
+		writePacketOtherThanDividers(output, random);
+		output << '\n';
+	}
+}
+
+// Size: number of rock paths. The cave depth grows with the square root of the size, so the sand
+// volume of part two grows roughly linearly.
+void generateDay14(std::ostream& output, Random& random, int64_t size) {
+	constexpr int64_t sourceX = 500;
+	const auto maxY = 20 + static_cast<int64_t>(std::sqrt(static_cast<double>(size)) * 8);
+	// A shelf below the source, so the sand of part one does not fall straight into the abyss.
+	output << sourceX - maxY / 4 << ',' << maxY << " -> " << sourceX + maxY / 4 << ',' << maxY << '\n';
+	for (int64_t rockPath = 1; rockPath < size; ++rockPath) {
+		int64_t x = sourceX + random.between(-maxY, maxY);
+		int64_t y = random.between(2, maxY);
+		output << x << ',' << y;
+		const auto numSegments = random.between(1, 5);
+		bool isHorizontal = random.chance(50);
+		for (int64_t segment = 0; segment < numSegments; ++segment) {
+			const auto length = random.between(1, 12) * (random.chance(50) ? 1 : -1);
+			if (isHorizontal) {
+				x += length;
+			} else {
+				y += y + length < 2 || y + length > maxY ? -length : length;
+			}
+			isHorizontal = !isHorizontal;
+			output << " -> " << x << ',' << y;
+		}
+		output << '\n';
+	}
+}
+
+// Size: number of sensors. Every sensor range ends right next to one hidden point, so that point
+// stays uncovered while the ranges cover most of the search area.
+void generateDay15(std::ostream& output, Random& random, int64_t size) {
+	constexpr int64_t maxCoordinate = 4000000;
+	const int64_t hiddenX = random.between(0, maxCoordinate);
+	const int64_t hiddenY = random.between(0, maxCoordinate);
+	for (int64_t sensor = 0; sensor < size; ++sensor) {
+		int64_t x, y, range;
+		do {
+			x = random.between(0, maxCoordinate);
+			y = random.between(0, maxCoordinate);
+			range = std::abs(x - hiddenX) + std::abs(y - hiddenY) - 1;
+		} while (range < 1);
+		const auto offsetX = random.between(0, range);
+		const auto offsetY = range - offsetX;
+		const auto beaconX = x + (random.chance(50) ? offsetX : -offsetX);
+		const auto beaconY = y + (random.chance(50) ? offsetY : -offsetY);
+		output << "Sensor at x=" << x << ", y=" << y << ": closest beacon is at x=" << beaconX << ", y=" << beaconY << '\n';
+	}
+}
+
+// Size: number of valves, at most 676 two letter names. Only a handful of valves get a flow rate,
+// like in the puzzle, otherwise the search space explodes.
+void generateDay16(std::ostream& output, Random& random, int64_t size) {
+	constexpr int64_t maxValves = 26 * 26;
+	size = std::clamp<int64_t>(size, 2, maxValves);
+
+	std::vector<std::string> names;
+	for (char first : uppercaseLetters) {
+		for (char second : uppercaseLetters) {
+			if (first != 'A' || second != 'A') {
+				names.push_back({ first, second });
+			}
+		}
+	}
+	random.shuffle(names);
+	names.resize(size - 1);
+	names.insert(names.begin(), "AA");
+
+	std::vector<std::vector<int64_t>> tunnels(size);
+	const auto connect = [&tunnels](int64_t first, int64_t second) {
+		if (first == second || std::find(tunnels[first].begin(), tunnels[first].end(), second) != tunnels[first].end()) {
+			return;
+		}
+		tunnels[first].push_back(second);
+		tunnels[second].push_back(first);
+	};
+	for (int64_t valve = 1; valve < size; ++valve) {
+		connect(valve, random.between(0, valve - 1));
+	}
+	for (int64_t extraTunnel = 0; extraTunnel < size / 2; ++extraTunnel) {
+		connect(random.between(0, size - 1), random.between(0, size - 1));
+	}
+
+	std::vector<int64_t> flowRates(size, 0);
+	const auto numWorkingValves = std::clamp<int64_t>(size / 4, 1, 15);
+	for (int64_t working = 0; working < numWorkingValves;) {
+		const auto valve = random.between(1, size - 1);
+		if (flowRates[valve] == 0) {
+			flowRates[valve] = random.between(1, 25);
+			++working;
+		}
+	}
+
+	for (int64_t valve = 0; valve < size; ++valve) {
+		output << "Valve " << names[valve] << " has flow rate=" << flowRates[valve];
+		output << (tunnels[valve].size() == 1 ? "; tunnel leads to valve " : "; tunnels lead to valves ");
+		for (size_t i = 0; i < tunnels[valve].size(); ++i) {
+			output << (i == 0 ? "" : ", ") << names[tunnels[valve][i]];
+		}
+		output << '\n';
+	}
+}
+
+// Size: length of the jet pattern. Part two expects the tower to repeat once per pass over the
+// pattern, which short patterns do not guarantee.
+void generateDay17(std::ostream& output, Random& random, int64_t size) {
+	size = std::max<int64_t>(size, 1000);
+	std::string jets(size, '<');
+	std::generate(jets.begin(), jets.end(), [&random]() {
+		return randomLetter(random, "<>");
+	});
+	output << jets << '\n';
+}
+
+// Size: number of unique cubes, packed into a box filled to about a third.
+void generateDay18(std::ostream& output, Random& random, int64_t size) {
+	const auto side = static_cast<int64_t>(std::cbrt(static_cast<double>(size) * 3)) + 1;
+	size = std::min(size, side * side * side);
+	std::unordered_set<int64_t> cubes;
+	while (static_cast<int64_t>(cubes.size()) < size) {
+		const auto x = random.between(0, side - 1);
+		const auto y = random.between(0, side - 1);
+		const auto z = random.between(0, side - 1);
+		if (cubes.insert((x * side + y) * side + z).second) {
+			output << x << ',' << y << ',' << z << '\n';
+		}
+	}
+}
+
+// Size: number of encrypted values, exactly one of them is zero.
+void generateDay20(std::ostream& output, Random& random, int64_t size) {
+	const auto zeroIndex = random.between(0, size - 1);
+	for (int64_t i = 0; i < size; ++i) {
+		int64_t value = 0;
+		while (i != zeroIndex && value == 0) {
+			value = random.between(-10000, 10000);
+		}
+		output << value << '\n';
+	}
+}
+
+class MonkeyTreeBuilder {
+public:
+	MonkeyTreeBuilder(std::ostream& output, Random& random, int64_t size) : output(output), random(random) {
+		nameLength = size < 400000 ? 4 : 5;
+	}
+
+	// Writes a random expression of the given number of monkeys and returns its root name and value.
+	std::pair<std::string, int64_t> buildExpression(int64_t numMonkeys) {
+		const auto name = createName();
+		if (numMonkeys <= 1) {
+			const auto value = random.between(1, 10);
+			lines.push_back(name + ": " + std::to_string(value));
+			return { name, value };
+		}
+
+		const auto leftSize = 1 + 2 * random.between(0, (numMonkeys - 3) / 2);
+		const auto [leftName, left] = buildExpression(leftSize);
+		const auto [rightName, right] = buildExpression(numMonkeys - 1 - leftSize);
+		std::string actions = "+-";
+		if (right != 0 && std::abs(left) <= maxValue / std::abs(right)) {
+			actions += '*';
+		}
+		if (right != 0 && left % right == 0) {
+			actions += '/';
+		}
+		const char action = randomLetter(random, actions);
+		addOperation(name, leftName, action, rightName);
+		return { name, calculate(left, right, action) };
+	}
+
+	// Builds the chain of operations from humn up to root, growing the value the human has to yell
+	// with invertible operations only, so part two always has an exact integer answer.
+	void build(int64_t size) {
+		const auto pathLength = std::max<int64_t>(1, static_cast<int64_t>(std::sqrt(static_cast<double>(size))));
+		std::vector<int64_t> expressionSizes(pathLength + 1, 1);
+		for (int64_t extra = (size - 4 - 2 * pathLength - 1) / 2; extra > 0; --extra) {
+			expressionSizes[random.between(0, pathLength)] += 2;
+		}
+
+		const auto answer = random.between(1, 1000000);
+		int64_t value = answer;
+		std::string child = "humn";
+		for (int64_t step = 0; step < pathLength; ++step) {
+			const auto [siblingName, sibling] = buildExpression(expressionSizes[step]);
+			std::string actions = "+-";
+			if (sibling != 0 && std::abs(value) <= maxValue / std::abs(sibling)) {
+				actions += '*';
+			}
+			if (sibling != 0 && value % sibling == 0) {
+				actions += '/';
+			}
+			const char action = randomLetter(random, actions);
+			const auto name = createName();
+			const bool isChildLeft = action == '/' || random.chance(50);
+			if (isChildLeft) {
+				addOperation(name, child, action, siblingName);
+				value = calculate(value, sibling, action);
+			} else {
+				addOperation(name, siblingName, action, child);
+				value = calculate(sibling, value, action);
+			}
+			child = name;
+		}
+
+		const auto [otherName, other] = buildExpression(expressionSizes.back());
+		const auto balanceName = createName();
+		const auto balanceValueName = createName();
+		lines.push_back(balanceValueName + ": " + std::to_string(std::abs(value - other)));
+		addOperation(balanceName, otherName, value >= other ? '+' : '-', balanceValueName);
+
+		if (random.chance(50)) {
+			addOperation("root", child, '+', balanceName);
+		} else {
+			addOperation("root", balanceName, '+', child);
+		}
+		lines.push_back("humn: " + std::to_string(random.between(1, 5000)));
+
+		random.shuffle(lines);
+		for (const auto& line : lines) {
+			output << line << '\n';
+		}
+	}
+
+private:
+	static constexpr int64_t maxValue = 1000000000000;
+
+	static int64_t calculate(int64_t left, int64_t right, char action) {
+		switch (action) {
+		case '+': return left + right;
+		case '-': return left - right;
+		case '*': return left * right;
+		default: return left / right;
+		}
+	}
+
+	void addOperation(const std::string& name, const std::string& left, char action, const std::string& right) {
+		lines.push_back(name + ": " + left + ' ' + action + ' ' + right);
+	}
+
+	std::string createName() {
+		std::string name(nameLength, 'a');
+		do {
+			std::generate(name.begin(), name.end(), [this]() {
+				return randomLetter(random, lowercaseLetters);
+			});
+		} while (name == "root" || name == "humn" || !usedNames.insert(name).second);
+		return name;
+	}
+
+	std::ostream& output;
+	Random& random;
+	size_t nameLength;
+	std::unordered_set<std::string> usedNames;
+	std::vector<std::string> lines;
+};
+
+// Size: number of monkeys.
+void generateDay21(std::ostream& output, Random& random, int64_t size) {
+	MonkeyTreeBuilder(output, random, size).build(std::max<int64_t>(size, 7));
+}
+
+// Size: edge length of the cube. The map uses the same net as the puzzle input:
+//  .AB
+//  .C.
+//  DE.
+//  F..
+void generateDay22(std::ostream& output, Random& random, int64_t size) {
+	constexpr std::array<std::string_view, 4> net{ " ##", " # ", "## ", "#  " };
+	for (size_t faceRow = 0; faceRow < net.size(); ++faceRow) {
+		const auto faces = net[faceRow].substr(0, net[faceRow].find_last_of('#') + 1);
+		for (int64_t y = 0; y < size; ++y) {
+			std::string line;
+			for (const char face : faces) {
+				for (int64_t x = 0; x < size; ++x) {
+					const bool isStart = line.empty() || line.back() == ' ';
+					const bool isStartTile = faceRow == 0 && y == 0 && isStart;
+					if (face == ' ') {
+						line += ' ';
+					} else {
+						line += !isStartTile && random.chance(5) ? '#' : '.';
+					}
+				}
+			}
+			output << line << '\n';
+		}
+	}
+
+	output << '\n' << random.between(1, size);
+	for (int64_t command = 0; command < size * 40; ++command) {
+		output << randomLetter(random, "LR") << random.between(1, size);
+	}
+	output << '\n';
+}
+
+} // namespace
+
+const std::map<int, Generator>& getGenerators() {
+	static const std::map<int, Generator> generators{
+		{ 1, { generateDay01, 1000000, "elves" } },
+		{ 2, { generateDay02, 1000000, "rounds" } },
+		{ 3, { generateDay03, 300000, "rucksacks" } },
+		{ 4, { generateDay04, 1000000, "pairs" } },
+		{ 5, { generateDay05, 100000, "crates and moves" } },
+		{ 6, { generateDay06, 10000000, "characters" } },
+		{ 7, { generateDay07, 100000, "files and directories" } },
+		{ 8, { generateDay08, 1000, "grid edge length" } },
+		{ 9, { generateDay09, 100000, "motions" } },
+		{ 10, { generateDay10, 1000000, "instructions" } },
+		{ 11, { generateDay11, 1000, "items" } },
+		{ 12, { generateDay12, 2000, "grid edge length" } },
+		{ 13, { generateDay13, 10000, "packet pairs" } },
+		{ 14, { generateDay14, 1000, "rock paths" } },
+		{ 15, { generateDay15, 100, "sensors" } },
+		{ 16, { generateDay16, 60, "valves" } },
+		{ 17, { generateDay17, 100000, "jets" } },
+		{ 18, { generateDay18, 100000, "cubes" } },
+		{ 20, { generateDay20, 1000000, "numbers" } },
+		{ 21, { generateDay21, 100000, "monkeys" } },
+		{ 22, { generateDay22, 500, "cube edge length" } },
+	};
+	return generators;
+}
+
+} // namespace generator
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <random>
+
+namespace generator {
+
+// Bounded values are derived from the raw std::mt19937_64 output, so the same seed produces
+// the same input with every standard library (distributions are implementation defined).
+class Random {
+public:
+	explicit Random(uint64_t seed) : engine(seed) {}
+
+	int64_t between(int64_t min, int64_t max) {
+		const auto range = static_cast<uint64_t>(max - min) + 1;
+		return min + static_cast<int64_t>(engine() % range);
+	}
+
+	bool chance(int percent) {
+		return between(1, 100) <= percent;
+	}
+
+	template<typename Container>
+	void shuffle(Container& container) {
+		for (int64_t i = static_cast<int64_t>(container.size()) - 1; i > 0; --i) {
+			std::swap(container[i], container[between(0, i)]);
+		}
+	}
+
+private:
+	std::mt19937_64 engine;
+};
+
+using GenerateFunction = void(*)(std::ostream& output, Random& random, int64_t size);
+
+struct Generator {
+	GenerateFunction generate;
+	int64_t defaultSize;
+	const char* sizeDescription;
+};
+
+const std::map<int, Generator>& getGenerators();
+
+} // namespace generator
@@ -0,0 +1,83 @@
+#include "Generators.h"
+#include "../utils/CommandLine.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct GeneratorOptions {
+	std::vector<int> days;
+	int64_t size{ 0 };
+	uint64_t seed{ 2022 };
+	std::string outputDir{ "generated" };
+};
+
+[[noreturn]] void exitWithUsage(const std::string& error) {
+	std::cerr << error << '\n'
+		<< "Usage: generator [--days 1-22] [--size N] [--seed S] [--output-dir DIR]" << std::endl;
+	exit(-1);
+}
+
+GeneratorOptions parseArgs(int argc, char** argv) {
+	GeneratorOptions options;
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == "--days" && hasValue) {
+			if (!common::tryParseNumberList(argv[++i], options.days)) {
+				exitWithUsage("Invalid day list: " + std::string(argv[i]));
+			}
+		} else if (arg == "--size" && hasValue) {
+			if (!common::tryParseInt(argv[++i], options.size) || options.size < 0) {
+				exitWithUsage("Invalid size: " + std::string(argv[i]));
+			}
+		} else if (arg == "--seed" && hasValue) {
+			if (!common::tryParseInt(argv[++i], options.seed)) {
+				exitWithUsage("Invalid seed: " + std::string(argv[i]));
+			}
+		} else if (arg == "--output-dir" && hasValue) {
+			options.outputDir = argv[++i];
+		} else {
+			exitWithUsage("Unknown argument: " + std::string(arg));
+		}
+	}
+
+	const auto& generators = generator::getGenerators();
+	for (const int day : options.days) {
+		if (!generators.contains(day)) {
+			exitWithUsage("Unknown day: " + std::to_string(day));
+		}
+	}
+	return options;
+}
+
+int main(int argc, char** argv) {
+	const auto options = parseArgs(argc, argv);
+	const auto& generators = generator::getGenerators();
+	for (const auto& [day, dayGenerator] : generators) {
+		const bool selected = options.days.empty() || std::find(options.days.begin(), options.days.end(), day) != options.days.end();
+		if (!selected) {
+			continue;
+		}
+
+		const auto directory = std::filesystem::path(options.outputDir) / common::dayDirName(day);
+		std::filesystem::create_directories(directory);
+		const auto inputPath = directory / "input.txt";
+		std::ofstream output(inputPath, std::ios::binary);
+		if (!output) {
+			std::cerr << "Cannot write " << inputPath.string() << std::endl;
+			return -1;
+		}
+
+		const auto size = options.size > 0 ? options.size : dayGenerator.defaultSize;
+		// Every day gets its own stream, so the output does not depend on which days are selected.
+		generator::Random random(options.seed * 100 + day);
+		dayGenerator.generate(output, random, size);
+		std::cout << common::dayDirName(day) << ": " << size << ' ' << dayGenerator.sizeDescription << " -> " << inputPath.string() << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,181 @@
+#include "../common/pch.h"
+#include "../utils/CommandLine.h"
+#include "../utils/DayRegistry.h"
+#include "../utils/Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+struct RunnerOptions {
+	std::vector<int> days;
+	std::vector<int> parts{ 1, 2 };
+	std::string inputDir{ "." };
+	int threads{ static_cast<int>(std::max(1u, std::thread::hardware_concurrency())) };
+};
+
+struct DayTask {
+	int day;
+	std::string inputPath;
+	const common::DayRunner* runner;
+};
+
+[[noreturn]] void exitWithUsage(const std::string& error) {
+	std::cerr << error << '\n'
+		<< "Usage: runner [--days 1-22] [--parts 1,2] [--input-dir DIR] [--threads N]" << std::endl;
+	exit(-1);
+}
+
+RunnerOptions parseArgs(int argc, char** argv) {
+	RunnerOptions options;
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == "--days" && hasValue) {
+			if (!common::tryParseNumberList(argv[++i], options.days)) {
+				exitWithUsage("Invalid day list: " + std::string(argv[i]));
+			}
+		} else if (arg == "--parts" && hasValue) {
+			if (!common::tryParseNumberList(argv[++i], options.parts)) {
+				exitWithUsage("Invalid part list: " + std::string(argv[i]));
+			}
+		} else if (arg == "--input-dir" && hasValue) {
+			options.inputDir = argv[++i];
+		} else if (arg == "--threads" && hasValue) {
+			if (!common::tryParseInt(argv[++i], options.threads)) {
+				exitWithUsage("Invalid thread count: " + std::string(argv[i]));
+			}
+			options.threads = std::max(1, options.threads);
+		} else {
+			exitWithUsage("Unknown argument: " + std::string(arg));
+		}
+	}
+
+	const auto& registeredDays = common::DayRegistry::instance().getDays();
+	for (const int day : options.days) {
+		if (!registeredDays.contains(day)) {
+			exitWithUsage("Unknown day: " + std::to_string(day));
+		}
+	}
+	for (const int part : options.parts) {
+		if (part != 1 && part != 2) {
+			exitWithUsage("Unknown part: " + std::to_string(part));
+		}
+	}
+	return options;
+}
+
+std::vector<DayTask> createTasks(const RunnerOptions& options) {
+	const auto& registeredDays = common::DayRegistry::instance().getDays();
+	std::vector<DayTask> tasks;
+	for (const auto& [day, runner] : registeredDays) {
+		const bool selected = options.days.empty() || std::find(options.days.begin(), options.days.end(), day) != options.days.end();
+		if (!selected) {
+			continue;
+		}
+		const auto inputPath = std::filesystem::path(options.inputDir) / common::dayDirName(day) / "input.txt";
+		if (!std::filesystem::exists(inputPath)) {
+			std::cerr << "Skipping day " << day << ", missing input: " << inputPath.string() << std::endl;
+			continue;
+		}
+		tasks.push_back({ day, inputPath.string(), &runner });
+	}
+	return tasks;
+}
+
+std::vector<common::DayReport> runTasks(const std::vector<DayTask>& tasks, const RunnerOptions& options) {
+	std::vector<common::DayReport> reports(tasks.size());
+	std::atomic<size_t> nextTask{ 0 };
+	auto worker = [&]() {
+		for (size_t taskIdx = nextTask++; taskIdx < tasks.size(); taskIdx = nextTask++) {
+			const auto& task = tasks[taskIdx];
+			// A broken input only fails its own day, the other days still run and get reported.
+			try {
+				reports[taskIdx] = (*task.runner)(task.inputPath, options.parts);
+			} catch (const std::exception& exception) {
+				reports[taskIdx].day = task.day;
+				reports[taskIdx].error = exception.what();
+			}
+		}
+	};
+
+	const auto numThreads = std::min<size_t>(options.threads, tasks.size());
+	// Days running side by side already keep the cores busy, a day spreading over more threads
+	// would only compete with them.
+	if (numThreads > 1) {
+		common::setSolverThreads(1);
+	}
+	std::vector<std::thread> workers;
+	for (size_t i = 1; i < numThreads; ++i) {
+		workers.emplace_back(worker);
+	}
+	worker();
+	for (auto& thread : workers) {
+		thread.join();
+	}
+	return reports;
+}
+
+std::string formatMicroseconds(std::chrono::nanoseconds duration) {
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(1) << duration.count() / 1000.0 << " us";
+	return stream.str();
+}
+
+void printReports(const std::vector<common::DayReport>& reports, std::chrono::nanoseconds wallTime) {
+	constexpr int dayWidth = 5;
+	constexpr int partWidth = 6;
+	constexpr int answerWidth = 20;
+	constexpr int timeWidth = 16;
+	constexpr int allocationsWidth = 12;
+
+	std::cout << std::left << std::setw(dayWidth) << "Day" << std::setw(partWidth) << "Part"
+		<< std::setw(answerWidth) << "Answer" << std::right << std::setw(timeWidth) << "Time"
+		<< std::setw(allocationsWidth) << "Allocs" << '\n';
+
+	std::chrono::nanoseconds totalTime{ 0 };
+	for (const auto& report : reports) {
+		if (!report.error.empty()) {
+			continue;
+		}
+		std::cout << std::left << std::setw(dayWidth) << report.day << std::setw(partWidth) << "read"
+			<< std::setw(answerWidth) << "" << std::right << std::setw(timeWidth) << formatMicroseconds(report.readDuration) << '\n';
+		totalTime += report.readDuration;
+		for (const auto& part : report.parts) {
+			std::cout << std::left << std::setw(dayWidth) << report.day << std::setw(partWidth) << part.part
+				<< std::setw(answerWidth) << part.answer << std::right << std::setw(timeWidth) << formatMicroseconds(part.duration)
+				<< std::setw(allocationsWidth) << part.allocations << '\n';
+			totalTime += part.duration;
+		}
+	}
+	std::cout << "Total: " << formatMicroseconds(totalTime) << " summed, " << formatMicroseconds(wallTime) << " wall" << std::endl;
+
+	for (const auto& report : reports) {
+		if (!report.error.empty()) {
+			std::cerr << "day " << report.day << ": " << report.error << std::endl;
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	const auto options = parseArgs(argc, argv);
+	const auto tasks = createTasks(options);
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto reports = runTasks(tasks, options);
+	const auto wallTime = std::chrono::steady_clock::now() - start;
+
+	printReports(reports, wallTime);
+	const bool allSucceeded = std::all_of(reports.begin(), reports.end(), [](const common::DayReport& report) {
+		return report.error.empty();
+	});
+	return allSucceeded ? 0 : -1;
+}
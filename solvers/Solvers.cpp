@@ -0,0 +1,38 @@
+#include "Solvers.h"
+
+namespace common {
+
+const std::map<int, const Solver*>& getSolvers() {
+	static const std::map<int, const Solver*> solvers{
+		{ 1, &day01::getSolver() },
+		{ 2, &day02::getSolver() },
+		{ 3, &day03::getSolver() },
+		{ 4, &day04::getSolver() },
+		{ 5, &day05::getSolver() },
+		{ 6, &day06::getSolver() },
+		{ 7, &day07::getSolver() },
+		{ 8, &day08::getSolver() },
+		{ 9, &day09::getSolver() },
+		{ 10, &day10::getSolver() },
+		{ 11, &day11::getSolver() },
+		{ 12, &day12::getSolver() },
+		{ 13, &day13::getSolver() },
+		{ 14, &day14::getSolver() },
+		{ 15, &day15::getSolver() },
+		{ 16, &day16::getSolver() },
+		{ 17, &day17::getSolver() },
+		{ 18, &day18::getSolver() },
+		{ 20, &day20::getSolver() },
+		{ 21, &day21::getSolver() },
+		{ 22, &day22::getSolver() },
+	};
+	return solvers;
+}
+
+const Solver* findSolver(int day) {
+	const auto& solvers = getSolvers();
+	const auto solver = solvers.find(day);
+	return solver != solvers.end() ? solver->second : nullptr;
+}
+
+} // namespace common
@@ -0,0 +1,35 @@
+#pragma once
+#include "../utils/Solver.h"
+#include <map>
+
+namespace day01 { const common::Solver& getSolver(); }
+namespace day02 { const common::Solver& getSolver(); }
+namespace day03 { const common::Solver& getSolver(); }
+namespace day04 { const common::Solver& getSolver(); }
+namespace day05 { const common::Solver& getSolver(); }
+namespace day06 { const common::Solver& getSolver(); }
+namespace day07 { const common::Solver& getSolver(); }
+namespace day08 { const common::Solver& getSolver(); }
+namespace day09 { const common::Solver& getSolver(); }
+namespace day10 { const common::Solver& getSolver(); }
+namespace day11 { const common::Solver& getSolver(); }
+namespace day12 { const common::Solver& getSolver(); }
+namespace day13 { const common::Solver& getSolver(); }
+namespace day14 { const common::Solver& getSolver(); }
+namespace day15 { const common::Solver& getSolver(); }
+namespace day16 { const common::Solver& getSolver(); }
+namespace day17 { const common::Solver& getSolver(); }
+namespace day18 { const common::Solver& getSolver(); }
+namespace day20 { const common::Solver& getSolver(); }
+namespace day21 { const common::Solver& getSolver(); }
+namespace day22 { const common::Solver& getSolver(); }
+
+namespace common {
+
+// All days of the solver library, keyed by day number.
+const std::map<int, const Solver*>& getSolvers();
+
+// Returns nullptr if the day is not part of the library.
+const Solver* findSolver(int day);
+
+} // namespace common
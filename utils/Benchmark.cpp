@@ -0,0 +1,101 @@
+#include "Benchmark.h"
+#include "CommandLine.h"
+#include "Parallel.h"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string_view>
+
+namespace {
+
+int parseIntArg(std::string_view arg, std::string_view prefix, int defaultValue) {
+	if (!arg.starts_with(prefix)) {
+		return defaultValue;
+	}
+	int value = 0;
+	if (!common::tryParseInt(arg.substr(prefix.size()), value)) {
+		std::cerr << "Invalid value: " << arg << '\n'
+			<< "Usage: dayXX [--bench] [--samples=N] [--warmup=N]" << std::endl;
+		exit(-1);
+	}
+	return value;
+}
+
+std::string formatDuration(std::chrono::nanoseconds duration) {
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(1);
+	const auto ns = duration.count();
+	if (ns < 10000) {
+		stream << ns << " ns";
+	} else if (ns < 10000000) {
+		stream << ns / 1000.0 << " us";
+	} else {
+		stream << ns / 1000000.0 << " ms";
+	}
+	return stream.str();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+	common::getAllocationCounter().fetch_add(1, std::memory_order_relaxed);
+	if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+namespace common {
+
+BenchmarkOptions BenchmarkOptions::fromArgs(int argc, char** argv) {
+	BenchmarkOptions options;
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		if (arg == "--bench") {
+			options.enabled = true;
+		}
+		options.samples = std::max(1, parseIntArg(arg, "--samples=", options.samples));
+		options.warmupIterations = std::max(0, parseIntArg(arg, "--warmup=", options.warmupIterations));
+	}
+	return options;
+}
+
+uint64_t getAllocationCount() {
+	return getAllocationCounter().load(std::memory_order_relaxed);
+}
+
+BenchmarkStats calculateStats(std::vector<std::chrono::nanoseconds> durations, uint64_t allocations, int warmupIterations) {
+	BenchmarkStats stats;
+	if (durations.empty()) {
+		return stats;
+	}
+	std::sort(durations.begin(), durations.end());
+	const auto count = durations.size();
+	stats.min = durations.front();
+	stats.median = durations[count / 2];
+	stats.p99 = durations[std::min(count - 1, count * 99 / 100)];
+	stats.allocationsPerRun = static_cast<double>(allocations) / count;
+	stats.samples = static_cast<int>(count);
+	stats.warmupIterations = warmupIterations;
+	return stats;
+}
+
+void printBenchmark(const std::string& name, const std::string& result, const BenchmarkStats& stats) {
+	std::cout << name << ": " << result
+		<< " | min " << formatDuration(stats.min)
+		<< " | median " << formatDuration(stats.median)
+		<< " | p99 " << formatDuration(stats.p99)
+		<< " | " << std::fixed << std::setprecision(1) << stats.allocationsPerRun << " allocs/run"
+		<< " (" << stats.samples << " samples, " << stats.warmupIterations << " warmup)" << std::endl;
+}
+
+} // namespace common
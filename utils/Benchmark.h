@@ -0,0 +1,101 @@
+#pragma once
+#include "../common/pch.h"
+#include "Solver.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace common {
+
+struct BenchmarkOptions {
+	bool enabled{ false };
+	int warmupIterations{ 3 };
+	int samples{ 50 };
+
+	// Recognizes --bench, --samples=N and --warmup=N, everything else is ignored.
+	static BenchmarkOptions fromArgs(int argc, char** argv);
+};
+
+struct BenchmarkStats {
+	std::chrono::nanoseconds min{ 0 };
+	std::chrono::nanoseconds median{ 0 };
+	std::chrono::nanoseconds p99{ 0 };
+	double allocationsPerRun{ 0.0 };
+	int samples{ 0 };
+	int warmupIterations{ 0 };
+};
+
+// Number of operator new calls made by the current thread so far, including those of the helper
+// threads it started through runOnThreads().
+uint64_t getAllocationCount();
+
+BenchmarkStats calculateStats(std::vector<std::chrono::nanoseconds> durations, uint64_t allocations, int warmupIterations);
+
+void printBenchmark(const std::string& name, const std::string& result, const BenchmarkStats& stats);
+
+namespace detail {
+
+template<typename Func>
+struct TakesInputByValue : std::false_type {};
+
+template<typename Result, typename Arg>
+struct TakesInputByValue<Result(*)(Arg)> : std::bool_constant<!std::is_reference_v<Arg>> {};
+
+} // namespace detail
+
+// Solvers taking their input by value get a fresh copy prepared before the clock starts,
+// so the copy shows up neither in the timing nor in the allocation count.
+template<typename Func, typename Data>
+auto runSample(Func func, const Data& data, std::chrono::nanoseconds& duration, uint64_t& allocations) {
+	using Clock = std::chrono::steady_clock;
+	if constexpr (detail::TakesInputByValue<Func>::value) {
+		Data input = data;
+		const auto allocationsBefore = getAllocationCount();
+		const auto start = Clock::now();
+		auto result = func(std::move(input));
+		duration = Clock::now() - start;
+		allocations += getAllocationCount() - allocationsBefore;
+		return result;
+	} else {
+		const auto allocationsBefore = getAllocationCount();
+		const auto start = Clock::now();
+		auto result = func(data);
+		duration = Clock::now() - start;
+		allocations += getAllocationCount() - allocationsBefore;
+		return result;
+	}
+}
+
+template<typename Func, typename Data>
+void measureAndPrint(const std::string& name, Func func, const Data& data, const BenchmarkOptions& options) {
+	AOC_TRACE_SPAN(name);
+	if (!options.enabled) {
+		measureAndPrint(name, func, data);
+		return;
+	}
+
+	std::chrono::nanoseconds duration{ 0 };
+	uint64_t allocations = 0;
+	for (int i = 0; i < options.warmupIterations; ++i) {
+		runSample(func, data, duration, allocations);
+	}
+
+	allocations = 0;
+	std::vector<std::chrono::nanoseconds> durations;
+	durations.reserve(options.samples);
+	std::string result;
+	for (int i = 0; i < options.samples; ++i) {
+		result = detail::toString(runSample(func, data, duration, allocations));
+		durations.push_back(duration);
+	}
+
+	printBenchmark(name, result, calculateStats(std::move(durations), allocations, options.warmupIterations));
+}
+
+} // namespace common
@@ -0,0 +1,53 @@
+#pragma once
+#include <charconv>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace common {
+
+// Parses the whole text as an integer. Unlike std::stoi it reports malformed values instead of throwing.
+template<typename T>
+bool tryParseInt(std::string_view text, T& value) {
+	const char* end = text.data() + text.size();
+	const auto [numberEnd, error] = std::from_chars(text.data(), end, value);
+	return !text.empty() && error == std::errc{} && numberEnd == end;
+}
+
+// Parses lists like "1-5,7,10-12". Fails on malformed numbers and on ranges running backwards.
+inline bool tryParseNumberList(std::string_view list, std::vector<int>& numbers) {
+	numbers.clear();
+	while (true) {
+		const auto commaPos = list.find(',');
+		const auto range = list.substr(0, commaPos);
+		const auto dashPos = range.find('-');
+		int first = 0;
+		int last = 0;
+		if (dashPos == std::string_view::npos) {
+			if (!tryParseInt(range, first)) {
+				return false;
+			}
+			last = first;
+		} else if (!tryParseInt(range.substr(0, dashPos), first) || !tryParseInt(range.substr(dashPos + 1), last) || first > last) {
+			return false;
+		}
+		for (int number = first; number <= last; ++number) {
+			numbers.push_back(number);
+		}
+		if (commaPos == std::string_view::npos) {
+			return true;
+		}
+		list.remove_prefix(commaPos + 1);
+	}
+}
+
+// Folder of a day, which also holds its input.txt.
+inline std::string dayDirName(int day) {
+	std::ostringstream stream;
+	stream << "day" << std::setw(2) << std::setfill('0') << day;
+	return stream.str();
+}
+
+} // namespace common
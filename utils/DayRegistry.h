@@ -0,0 +1,85 @@
+#pragma once
+#include "Benchmark.h"
+#include "MappedFileReader.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace common {
+
+struct PartReport {
+	int part{ 0 };
+	std::string answer;
+	std::chrono::nanoseconds duration{ 0 };
+	uint64_t allocations{ 0 };
+};
+
+struct DayReport {
+	int day{ 0 };
+	std::chrono::nanoseconds readDuration{ 0 };
+	std::vector<PartReport> parts;
+	// what() of the exception that stopped the day, empty if it ran to the end.
+	std::string error;
+};
+
+using DayRunner = std::function<DayReport(const std::string& inputPath, const std::vector<int>& parts)>;
+
+class DayRegistry {
+public:
+	static DayRegistry& instance() {
+		static DayRegistry registry;
+		return registry;
+	}
+
+	void add(int day, DayRunner runner) {
+		days[day] = std::move(runner);
+	}
+
+	const std::map<int, DayRunner>& getDays() const {
+		return days;
+	}
+
+private:
+	DayRegistry() = default;
+
+	std::map<int, DayRunner> days;
+};
+
+// Instantiated once per day as a static object, so that linking the day into a binary makes it visible in the registry.
+class DayRegistration {
+public:
+	template<typename ParseFunc, typename PartOneFunc, typename PartTwoFunc>
+	DayRegistration(int day, ParseFunc parse, PartOneFunc partOne, PartTwoFunc partTwo) {
+		DayRegistry::instance().add(day, [day, parse, partOne, partTwo](const std::string& inputPath, const std::vector<int>& parts) {
+			using Clock = std::chrono::steady_clock;
+			AOC_TRACE_SPAN((day < 10 ? "day0" : "day") + std::to_string(day));
+			DayReport report;
+			report.day = day;
+
+			const auto start = Clock::now();
+			const MappedFile input(inputPath);
+			const auto data = parse(input.getContent());
+			report.readDuration = Clock::now() - start;
+
+			for (int part : parts) {
+				AOC_TRACE_SPAN("Part " + std::to_string(part));
+				PartReport partReport;
+				partReport.part = part;
+				if (part == 1) {
+					partReport.answer = detail::toString(runSample(partOne, data, partReport.duration, partReport.allocations));
+				} else if (part == 2) {
+					partReport.answer = detail::toString(runSample(partTwo, data, partReport.duration, partReport.allocations));
+				} else {
+					continue;
+				}
+				report.parts.push_back(std::move(partReport));
+			}
+			return report;
+		});
+	}
+};
+
+} // namespace common
@@ -0,0 +1,219 @@
+#pragma once
+#include "../common/pch.h"
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace common {
+
+// Two dimensional container backed by a single buffer. An optional padding border of the given
+// width surrounds the cells, so lookups next to the edge need no bounds checks. Rows and columns
+// are numbered from 0 to getRows() - 1 / getCols() - 1, the padding is reachable with negative
+// coordinates or coordinates past the end.
+template<typename T>
+class Grid {
+public:
+	// Strided view of one column.
+	template<typename Value>
+	class ColumnView {
+	public:
+		constexpr ColumnView(Value* first, int size, int stride) : first(first), numCells(size), stride(stride) {}
+
+		constexpr Value& operator[](int row) const {
+			return first[static_cast<ptrdiff_t>(row) * stride];
+		}
+
+		constexpr int size() const {
+			return numCells;
+		}
+
+	private:
+		Value* first;
+		int numCells;
+		int stride;
+	};
+
+	constexpr Grid() = default;
+
+	constexpr Grid(int rows, int cols, const T& value = T{}, int padding = 0)
+		: rows(rows), cols(cols), padding(padding), stride(cols + 2 * padding),
+		cells(static_cast<size_t>(rows + 2 * padding) * (cols + 2 * padding), value) {}
+
+	constexpr int getRows() const {
+		return rows;
+	}
+
+	constexpr int getCols() const {
+		return cols;
+	}
+
+	constexpr int getPadding() const {
+		return padding;
+	}
+
+	// Distance between vertically adjacent cells in the buffer.
+	constexpr int getStride() const {
+		return stride;
+	}
+
+	constexpr bool contains(int row, int col) const {
+		return row >= 0 && row < rows && col >= 0 && col < cols;
+	}
+
+	// Position in the buffer, neighbors are at index -1, +1, -stride and +stride.
+	constexpr int getIndex(int row, int col) const {
+		return (row + padding) * stride + col + padding;
+	}
+
+	constexpr int getRowOfIndex(int index) const {
+		return index / stride - padding;
+	}
+
+	constexpr int getColOfIndex(int index) const {
+		return index % stride - padding;
+	}
+
+	constexpr T& operator()(int row, int col) {
+		return cells[getIndex(row, col)];
+	}
+
+	constexpr const T& operator()(int row, int col) const {
+		return cells[getIndex(row, col)];
+	}
+
+	constexpr T& getCell(int index) {
+		return cells[index];
+	}
+
+	constexpr const T& getCell(int index) const {
+		return cells[index];
+	}
+
+	// Row view without padding, grid[row][col] reads like a nested vector.
+	constexpr std::span<T> operator[](int row) {
+		return { cells.data() + getIndex(row, 0), static_cast<size_t>(cols) };
+	}
+
+	constexpr std::span<const T> operator[](int row) const {
+		return { cells.data() + getIndex(row, 0), static_cast<size_t>(cols) };
+	}
+
+	constexpr ColumnView<T> getColumn(int col) {
+		return { cells.data() + getIndex(0, col), rows, stride };
+	}
+
+	constexpr ColumnView<const T> getColumn(int col) const {
+		return { cells.data() + getIndex(0, col), rows, stride };
+	}
+
+	// The whole buffer including the padding, getIndex() positions refer to it.
+	constexpr std::span<T> getStorage() {
+		return cells;
+	}
+
+	constexpr std::span<const T> getStorage() const {
+		return cells;
+	}
+
+	constexpr void fill(const T& value) {
+		std::fill(cells.begin(), cells.end(), value);
+	}
+
+private:
+	int rows{ 0 };
+	int cols{ 0 };
+	int padding{ 0 };
+	int stride{ 0 };
+	std::vector<T> cells;
+};
+
+// Same interface as common::MatrixIterator, walking a Grid from the given cell in one direction.
+template<typename T>
+class GridIterator {
+public:
+	GridIterator(const Grid<T>& grid, int row, int col, const Dir& dir) : grid(grid), row(row), col(col), dir(dir) {}
+
+	bool hasValue() const {
+		return grid.contains(row, col);
+	}
+
+	int getRow() const {
+		return row;
+	}
+
+	int getCol() const {
+		return col;
+	}
+
+	T next() {
+		const T value = grid(row, col);
+		row += dir.y;
+		col += dir.x;
+		return value;
+	}
+
+private:
+	const Grid<T>& grid;
+	int row;
+	int col;
+	Dir dir;
+};
+
+template<typename T>
+struct GridNeighbor {
+	int row;
+	int col;
+	T value;
+};
+
+// Grid counterpart of common::findNeighbors, ADJACENT yields the four orthogonal neighbors,
+// any other policy adds the diagonal ones.
+template<typename T>
+constexpr std::vector<GridNeighbor<T>> findNeighbors(const Grid<T>& grid, int row, int col, int distance, SearchPolicy policy) {
+	std::vector<GridNeighbor<T>> neighbors;
+	// The offsets step by the distance, a distance of 0 would never leave the center.
+	if (distance == 0) {
+		return neighbors;
+	}
+	for (int rowOffset = -distance; rowOffset <= distance; rowOffset += distance) {
+		for (int colOffset = -distance; colOffset <= distance; colOffset += distance) {
+			const bool isDiagonal = rowOffset != 0 && colOffset != 0;
+			const bool isCenter = rowOffset == 0 && colOffset == 0;
+			if (isCenter || (isDiagonal && policy == SearchPolicy::ADJACENT)) {
+				continue;
+			}
+			const int neighborRow = row + rowOffset;
+			const int neighborCol = col + colOffset;
+			if (grid.contains(neighborRow, neighborCol)) {
+				neighbors.push_back({ neighborRow, neighborCol, grid(neighborRow, neighborCol) });
+			}
+		}
+	}
+	return neighbors;
+}
+
+namespace detail {
+
+// Lookups in a corner, along the border, past the padding and at distance 0, evaluated at compile time.
+constexpr bool checkFindNeighbors() {
+	Grid<int> grid(3, 4, 0, 1);
+	for (int row = 0; row < grid.getRows(); ++row) {
+		for (int col = 0; col < grid.getCols(); ++col) {
+			grid(row, col) = row * 10 + col;
+		}
+	}
+	const auto corner = findNeighbors(grid, 0, 0, 1, SearchPolicy::ADJACENT);
+	const bool cornerMatches = corner.size() == 2 && corner[0].value == 1 && corner[1].value == 10;
+	const auto border = findNeighbors(grid, 2, 1, 1, SearchPolicy::ADJACENT);
+	const bool borderMatches = border.size() == 3 && border[0].value == 11 && border[1].value == 20 && border[2].value == 22;
+	const auto distant = findNeighbors(grid, 1, 1, 2, SearchPolicy::ADJACENT);
+	const bool distantMatches = distant.size() == 1 && distant[0].row == 1 && distant[0].col == 3 && distant[0].value == 13;
+	return cornerMatches && borderMatches && distantMatches && findNeighbors(grid, 1, 1, 0, SearchPolicy::ADJACENT).empty();
+}
+
+static_assert(checkFindNeighbors());
+
+} // namespace detail
+
+} // namespace common
@@ -0,0 +1,94 @@
+#include "MappedFileReader.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace common {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) {
+	fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE) {
+		fileHandle = nullptr;
+		throw std::runtime_error("Cannot open file: " + path);
+	}
+
+	LARGE_INTEGER fileSize;
+	GetFileSizeEx(fileHandle, &fileSize);
+	size = static_cast<size_t>(fileSize.QuadPart);
+	if (size == 0) {
+		return;
+	}
+
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle == nullptr) {
+		CloseHandle(fileHandle);
+		throw std::runtime_error("Cannot map file: " + path);
+	}
+	data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr) {
+		CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		throw std::runtime_error("Cannot map file: " + path);
+	}
+}
+
+MappedFile::~MappedFile() {
+	if (data != nullptr) {
+		UnmapViewOfFile(data);
+	}
+	if (mappingHandle != nullptr) {
+		CloseHandle(mappingHandle);
+	}
+	if (fileHandle != nullptr) {
+		CloseHandle(fileHandle);
+	}
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error("Cannot open file: " + path);
+	}
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0) {
+		close(fd);
+		throw std::runtime_error("Cannot read file size: " + path);
+	}
+	size = static_cast<size_t>(fileStat.st_size);
+	if (size == 0) {
+		close(fd);
+		return;
+	}
+
+	void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		throw std::runtime_error("Cannot map file: " + path);
+	}
+	madvise(mapping, size, MADV_SEQUENTIAL);
+	data = static_cast<const char*>(mapping);
+}
+
+MappedFile::~MappedFile() {
+	if (data != nullptr) {
+		munmap(const_cast<char*>(data), size);
+	}
+}
+
+#endif
+
+} // namespace common
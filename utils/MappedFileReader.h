@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace common {
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+public:
+	explicit MappedFile(const std::string& path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	std::string_view getContent() const {
+		return { data, size };
+	}
+
+private:
+	const char* data{ nullptr };
+	size_t size{ 0 };
+#ifdef _WIN32
+	void* fileHandle{ nullptr };
+	void* mappingHandle{ nullptr };
+#endif
+};
+
+// Splits a buffer into lines without copying, "\r\n" endings are handled as well.
+class LineReader {
+public:
+	explicit LineReader(std::string_view content) : content(content) {}
+
+	bool nextLine(std::string_view& line) {
+		if (position >= content.size()) {
+			return false;
+		}
+		auto lineEnd = content.find('\n', position);
+		if (lineEnd == std::string_view::npos) {
+			lineEnd = content.size();
+		}
+		line = content.substr(position, lineEnd - position);
+		position = lineEnd + 1;
+		if (!line.empty() && line.back() == '\r') {
+			line.remove_suffix(1);
+		}
+		return true;
+	}
+
+	bool nextLine(std::string& line) {
+		std::string_view view;
+		if (!nextLine(view)) {
+			return false;
+		}
+		line.assign(view);
+		return true;
+	}
+
+	std::string nextLine() {
+		std::string line;
+		nextLine(line);
+		return line;
+	}
+
+private:
+	std::string_view content;
+	size_t position{ 0 };
+};
+
+// Drop-in replacement for common::FileReader. Lines returned as std::string_view point into
+// the mapped file and stay valid as long as the reader exists.
+class MappedFileReader {
+public:
+	explicit MappedFileReader(const std::string& path) : file(path), lines(file.getContent()) {}
+
+	bool nextLine(std::string_view& line) {
+		return lines.nextLine(line);
+	}
+
+	bool nextLine(std::string& line) {
+		return lines.nextLine(line);
+	}
+
+	std::string nextLine() {
+		return lines.nextLine();
+	}
+
+	std::string_view getContent() const {
+		return file.getContent();
+	}
+
+private:
+	MappedFile file;
+	LineReader lines;
+};
+
+} // namespace common
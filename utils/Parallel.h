@@ -0,0 +1,56 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace common {
+
+namespace detail {
+
+inline thread_local std::atomic<uint64_t> threadAllocationCount{ 0 };
+// Set on helper threads to the counter of the thread that started them.
+inline thread_local std::atomic<uint64_t>* sharedAllocationCount = nullptr;
+// 0 stands for all hardware threads.
+inline std::atomic<size_t> solverThreads{ 0 };
+
+} // namespace detail
+
+// Counter the global operator new of the benchmark library adds to.
+inline std::atomic<uint64_t>& getAllocationCounter() {
+	return detail::sharedAllocationCount != nullptr ? *detail::sharedAllocationCount : detail::threadAllocationCount;
+}
+
+// Number of threads a single part may use. Defaults to all hardware threads, a caller solving several
+// days at once lowers it so the days do not oversubscribe the machine.
+inline size_t getSolverThreads() {
+	const size_t threads = detail::solverThreads.load(std::memory_order_relaxed);
+	return threads != 0 ? threads : std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+inline void setSolverThreads(size_t threads) {
+	detail::solverThreads.store(threads, std::memory_order_relaxed);
+}
+
+// Runs worker on the calling thread and on numThreads - 1 helper threads and waits for all of them.
+// Helpers count their allocations for the calling thread, so measuring a solver includes the work it
+// hands off. With a single thread the worker simply runs inline.
+template<typename Worker>
+void runOnThreads(size_t numThreads, Worker worker) {
+	std::atomic<uint64_t>& allocationCounter = getAllocationCounter();
+	std::vector<std::thread> helpers;
+	for (size_t i = 1; i < numThreads; ++i) {
+		helpers.emplace_back([&allocationCounter, &worker]() {
+			detail::sharedAllocationCount = &allocationCounter;
+			worker();
+		});
+	}
+	worker();
+	for (auto& helper : helpers) {
+		helper.join();
+	}
+}
+
+} // namespace common
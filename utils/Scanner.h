@@ -0,0 +1,149 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+namespace common {
+
+// Allocation free cursor over a string_view. Numbers are parsed with std::from_chars,
+// so the global locale is never consulted.
+class Scanner {
+public:
+	explicit Scanner(std::string_view text) : text(text) {}
+
+	static constexpr bool isDigit(char character) {
+		return character >= '0' && character <= '9';
+	}
+
+	static constexpr bool isWordCharacter(char character) {
+		return isDigit(character) || (character >= 'a' && character <= 'z') ||
+			(character >= 'A' && character <= 'Z') || character == '_';
+	}
+
+	bool atEnd() const {
+		return position >= text.size();
+	}
+
+	char peek() const {
+		return atEnd() ? '\0' : text[position];
+	}
+
+	std::string_view remaining() const {
+		return text.substr(position);
+	}
+
+	void skipSpaces() {
+		while (!atEnd() && (text[position] == ' ' || text[position] == '\t')) {
+			++position;
+		}
+	}
+
+	// Consumes the given separator if the cursor is positioned at it.
+	bool skip(char separator) {
+		if (peek() != separator) {
+			return false;
+		}
+		++position;
+		return true;
+	}
+
+	bool skip(std::string_view separator) {
+		if (!remaining().starts_with(separator)) {
+			return false;
+		}
+		position += separator.size();
+		return true;
+	}
+
+	// Skips everything up to the next digit and parses the number, '-' is treated as a separator.
+	template<typename T = int>
+	T nextInt() {
+		T value{};
+		tryNextInt(value);
+		return value;
+	}
+
+	template<typename T>
+	bool tryNextInt(T& value) {
+		while (!atEnd() && !isDigit(text[position])) {
+			++position;
+		}
+		return parseNumberAtCursor(value);
+	}
+
+	// Like nextInt, but a '-' directly preceding the digits makes the number negative.
+	template<typename T = int>
+	T nextSignedInt() {
+		T value{};
+		tryNextSignedInt(value);
+		return value;
+	}
+
+	template<typename T>
+	bool tryNextSignedInt(T& value) {
+		static_assert(std::is_signed_v<T>, "nextSignedInt requires a signed type");
+		while (!atEnd() && !isDigit(text[position])) {
+			const bool isMinusSign = text[position] == '-' && position + 1 < text.size() && isDigit(text[position + 1]);
+			if (isMinusSign) {
+				break;
+			}
+			++position;
+		}
+		return parseNumberAtCursor(value);
+	}
+
+	// Skips to the next run of [A-Za-z0-9_] characters and returns it.
+	std::string_view nextWord() {
+		while (!atEnd() && !isWordCharacter(text[position])) {
+			++position;
+		}
+		const auto wordStart = position;
+		while (!atEnd() && isWordCharacter(text[position])) {
+			++position;
+		}
+		return text.substr(wordStart, position - wordStart);
+	}
+
+	// Returns the next non blank character, '\0' when the input is exhausted.
+	char nextSymbol() {
+		skipSpaces();
+		const char symbol = peek();
+		if (!atEnd()) {
+			++position;
+		}
+		return symbol;
+	}
+
+	// Returns the text up to the separator and consumes the separator itself.
+	std::string_view nextUntil(char separator) {
+		const auto fieldStart = position;
+		auto fieldEnd = text.find(separator, position);
+		if (fieldEnd == std::string_view::npos) {
+			fieldEnd = text.size();
+		}
+		position = std::min(fieldEnd + 1, text.size());
+		return text.substr(fieldStart, fieldEnd - fieldStart);
+	}
+
+private:
+	template<typename T>
+	bool parseNumberAtCursor(T& value) {
+		if (atEnd()) {
+			return false;
+		}
+		const char* begin = text.data() + position;
+		const auto [numberEnd, error] = std::from_chars(begin, text.data() + text.size(), value);
+		if (error != std::errc{}) {
+			return false;
+		}
+		position += numberEnd - begin;
+		return true;
+	}
+
+	std::string_view text;
+	size_t position{ 0 };
+};
+
+} // namespace common
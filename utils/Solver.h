@@ -0,0 +1,74 @@
+#pragma once
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace common {
+
+namespace detail {
+
+// Answers are printed and returned as text in the form operator<< produces.
+template<typename Result>
+std::string toString(const Result& result) {
+	std::ostringstream stream;
+	stream << result;
+	return stream.str();
+}
+
+} // namespace detail
+
+// Parsed puzzle input, the concrete type stays private to the day that created it.
+class ParsedInput {
+public:
+	virtual ~ParsedInput() = default;
+};
+
+// Day independent entry points, so a solver can be embedded without knowing the types of its day.
+// Answers are returned in the same textual form the executables print.
+class Solver {
+public:
+	virtual ~Solver() = default;
+
+	virtual std::unique_ptr<ParsedInput> parse(std::string_view input) const = 0;
+	virtual std::string solvePart1(const ParsedInput& input) const = 0;
+	virtual std::string solvePart2(const ParsedInput& input) const = 0;
+};
+
+// Adapts the parse, partOne and partTwo functions of a day to the Solver interface.
+// A parsed input can be solved any number of times, solvers taking it by value get a copy.
+template<typename ParseFunc, typename PartOneFunc, typename PartTwoFunc>
+class DaySolver : public Solver {
+public:
+	DaySolver(ParseFunc parseFunc, PartOneFunc partOneFunc, PartTwoFunc partTwoFunc)
+		: parseFunc(parseFunc), partOneFunc(partOneFunc), partTwoFunc(partTwoFunc) {}
+
+	std::unique_ptr<ParsedInput> parse(std::string_view input) const override {
+		return std::make_unique<Input>(parseFunc(input));
+	}
+
+	std::string solvePart1(const ParsedInput& input) const override {
+		return detail::toString(partOneFunc(static_cast<const Input&>(input).data));
+	}
+
+	std::string solvePart2(const ParsedInput& input) const override {
+		return detail::toString(partTwoFunc(static_cast<const Input&>(input).data));
+	}
+
+private:
+	using DataType = std::decay_t<std::invoke_result_t<ParseFunc, std::string_view>>;
+
+	struct Input : ParsedInput {
+		explicit Input(DataType data) : data(std::move(data)) {}
+
+		DataType data;
+	};
+
+	ParseFunc parseFunc;
+	PartOneFunc partOneFunc;
+	PartTwoFunc partTwoFunc;
+};
+
+} // namespace common
@@ -0,0 +1,198 @@
+#include "Trace.h"
+
+#ifdef AOC_TRACE
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace common::trace {
+
+struct Node {
+	explicit Node(std::string_view name) : name(name) {}
+
+	Node* getChild(std::string_view childName) {
+		for (const auto& child : children) {
+			if (child->name == childName) {
+				return child.get();
+			}
+		}
+		children.push_back(std::make_unique<Node>(childName));
+		return children.back().get();
+	}
+
+	std::string name;
+	std::chrono::nanoseconds duration{ 0 };
+	uint64_t calls{ 0 };
+	// Keyed by the address of the literal, equal names from different translation units are merged on output.
+	std::vector<std::pair<const char*, uint64_t>> counters;
+	std::vector<std::unique_ptr<Node>> children;
+};
+
+namespace {
+
+// Every thread records into its own tree, the registry only keeps them alive until the output is written.
+class Registry {
+public:
+	static Registry& instance() {
+		static Registry registry;
+		return registry;
+	}
+
+	Node* createThreadRoot() {
+		std::lock_guard lock(mutex);
+		roots.push_back(std::make_unique<Node>("all"));
+		return roots.back().get();
+	}
+
+	std::vector<const Node*> getRoots() {
+		std::lock_guard lock(mutex);
+		std::vector<const Node*> result;
+		for (const auto& root : roots) {
+			result.push_back(root.get());
+		}
+		return result;
+	}
+
+private:
+	Registry() = default;
+
+	~Registry() {
+		const char* prefix = std::getenv("AOC_TRACE_OUTPUT");
+		const std::string outputPrefix = prefix != nullptr ? prefix : "trace";
+		std::ofstream json(outputPrefix + ".json");
+		writeJson(json);
+		std::ofstream folded(outputPrefix + ".folded");
+		writeFoldedStacks(folded);
+	}
+
+	std::mutex mutex;
+	std::vector<std::unique_ptr<Node>> roots;
+};
+
+Node*& currentNode() {
+	thread_local Node* current = Registry::instance().createThreadRoot();
+	return current;
+}
+
+struct MergedNode {
+	std::chrono::nanoseconds duration{ 0 };
+	uint64_t calls{ 0 };
+	std::map<std::string, uint64_t> counters;
+	std::map<std::string, MergedNode> children;
+};
+
+void merge(MergedNode& target, const Node& source) {
+	target.duration += source.duration;
+	target.calls += source.calls;
+	for (const auto& [name, value] : source.counters) {
+		target.counters[name] += value;
+	}
+	for (const auto& child : source.children) {
+		merge(target.children[child->name], *child);
+	}
+}
+
+MergedNode mergeThreads() {
+	MergedNode root;
+	for (const auto* threadRoot : Registry::instance().getRoots()) {
+		merge(root, *threadRoot);
+	}
+	for (const auto& [name, child] : root.children) {
+		root.duration += child.duration;
+	}
+	return root;
+}
+
+void writeJsonString(std::ostream& output, std::string_view text) {
+	output << '"';
+	for (const char character : text) {
+		if (character == '"' || character == '\\') {
+			output << '\\';
+		}
+		output << character;
+	}
+	output << '"';
+}
+
+void writeJsonNode(std::ostream& output, std::string_view name, const MergedNode& node, int depth) {
+	const std::string indent(depth * 2, ' ');
+	output << indent << "{\"name\": ";
+	writeJsonString(output, name);
+	output << ", \"calls\": " << node.calls << ", \"ns\": " << node.duration.count() << ", \"counters\": {";
+	bool isFirst = true;
+	for (const auto& [counterName, value] : node.counters) {
+		output << (isFirst ? "" : ", ");
+		writeJsonString(output, counterName);
+		output << ": " << value;
+		isFirst = false;
+	}
+	output << "}, \"children\": [";
+	isFirst = true;
+	for (const auto& [childName, child] : node.children) {
+		output << (isFirst ? "\n" : ",\n");
+		writeJsonNode(output, childName, child, depth + 1);
+		isFirst = false;
+	}
+	output << (node.children.empty() ? "]}" : "\n" + indent + "]}");
+}
+
+void writeFoldedNode(std::ostream& output, const std::string& stack, const MergedNode& node) {
+	auto selfDuration = node.duration;
+	for (const auto& [childName, child] : node.children) {
+		selfDuration -= child.duration;
+		writeFoldedNode(output, stack + ';' + childName, child);
+	}
+	if (selfDuration.count() > 0) {
+		output << stack << ' ' << selfDuration.count() << '\n';
+	}
+}
+
+} // namespace
+
+Span::Span(std::string_view name) {
+	auto& current = currentNode();
+	parent = current;
+	node = parent->getChild(name);
+	current = node;
+	start = std::chrono::steady_clock::now();
+}
+
+Span::~Span() {
+	node->duration += std::chrono::steady_clock::now() - start;
+	++node->calls;
+	currentNode() = parent;
+}
+
+void addToCounter(const char* name, uint64_t value) {
+	auto& counters = currentNode()->counters;
+	for (auto& [counterName, counterValue] : counters) {
+		if (counterName == name) {
+			counterValue += value;
+			return;
+		}
+	}
+	counters.push_back({ name, value });
+}
+
+void writeJson(std::ostream& output) {
+	const auto root = mergeThreads();
+	writeJsonNode(output, "all", root, 0);
+	output << '\n';
+}
+
+void writeFoldedStacks(std::ostream& output) {
+	const auto root = mergeThreads();
+	for (const auto& [name, child] : root.children) {
+		writeFoldedNode(output, name, child);
+	}
+}
+
+} // namespace common::trace
+
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+// Counters and spans for profiling solver inner loops. Without AOC_TRACE every macro expands to
+// nothing, so instrumented code costs nothing in regular builds.
+//
+//   AOC_TRACE_SPAN("dijkstra");       times the enclosing scope, spans nest into a call tree
+//   AOC_TRACE_COUNT("heap pops");     increments a counter of the innermost span
+//   AOC_TRACE_ADD("cells", n);        adds n to a counter of the innermost span
+//
+// At exit the profile of all threads is written to trace.json (time, calls and counters per span)
+// and trace.folded (self time per stack in ns, for flamegraph.pl). The AOC_TRACE_OUTPUT environment
+// variable replaces the "trace" file prefix.
+
+#ifdef AOC_TRACE
+
+#include <chrono>
+
+#define AOC_TRACE_CONCAT_IMPL(left, right) left##right
+#define AOC_TRACE_CONCAT(left, right) AOC_TRACE_CONCAT_IMPL(left, right)
+#define AOC_TRACE_SPAN(name) const ::common::trace::Span AOC_TRACE_CONCAT(aocTraceSpan, __LINE__)(name)
+#define AOC_TRACE_COUNT(name) ::common::trace::addToCounter(name, 1)
+#define AOC_TRACE_ADD(name, value) ::common::trace::addToCounter(name, static_cast<uint64_t>(value))
+
+namespace common::trace {
+
+struct Node;
+
+class Span {
+public:
+	explicit Span(std::string_view name);
+	~Span();
+
+	Span(const Span&) = delete;
+	Span& operator=(const Span&) = delete;
+
+private:
+	Node* node;
+	Node* parent;
+	std::chrono::steady_clock::time_point start;
+};
+
+// The name has to outlive the program, which string literals do.
+void addToCounter(const char* name, uint64_t value);
+
+// Merges the profiles of all threads, only call once the traced work has finished.
+void writeJson(std::ostream& output);
+void writeFoldedStacks(std::ostream& output);
+
+} // namespace common::trace
+
+#else
+
+#define AOC_TRACE_SPAN(name) ((void)0)
+#define AOC_TRACE_COUNT(name) ((void)0)
+#define AOC_TRACE_ADD(name, value) ((void)0)
+
+#endif